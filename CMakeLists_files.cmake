@@ -54,10 +54,12 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/timestepping/SimulatorTimer.cpp
   opm/simulators/timestepping/SimulatorTimerInterface.cpp
   opm/simulators/timestepping/gatherConvergenceReport.cpp
+  opm/simulators/utils/CellCostPartitioning.cpp
   opm/simulators/utils/DeferredLogger.cpp
   opm/simulators/utils/gatherDeferredLogger.cpp
   opm/simulators/utils/ParallelFileMerger.cpp
   opm/simulators/utils/ParallelRestart.cpp
+  opm/simulators/utils/PerformanceTimers.cpp
   opm/simulators/wells/ALQState.cpp
   opm/simulators/wells/BlackoilWellModelGeneric.cpp
   opm/simulators/wells/GasLiftGroupInfo.cpp
@@ -65,6 +67,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/GasLiftStage2.cpp
   opm/simulators/wells/GlobalWellInfo.cpp
   opm/simulators/wells/GroupState.cpp
+  opm/simulators/wells/GroupTree.cpp
   opm/simulators/wells/MultisegmentWellEval.cpp
   opm/simulators/wells/MultisegmentWellGeneric.cpp
   opm/simulators/wells/ParallelWellInfo.cpp
@@ -124,7 +127,8 @@ if(HAVE_AMGCL)
   endif()
 endif()
 if(MPI_FOUND)
-  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/ParallelEclipseState.cpp
+  list(APPEND MAIN_SOURCE_FILES opm/simulators/utils/DeckCache.cpp
+                                opm/simulators/utils/ParallelEclipseState.cpp
                                 opm/simulators/utils/ParallelSerialization.cpp)
 endif()
 
@@ -133,6 +137,8 @@ endif()
 list (APPEND TEST_SOURCE_FILES
   tests/test_equil.cc
   tests/test_ecl_output.cc
+  tests/test_ecltransmissibility.cc
+  tests/test_timesteprollback.cc
   tests/test_blackoil_amg.cpp
   tests/test_convergencereport.cpp
   tests/test_flexiblesolver.cpp
@@ -144,21 +150,29 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_wellmodel.cpp
   tests/test_deferredlogger.cpp
   tests/test_timer.cpp
+  tests/test_timestepcontrol.cpp
+  tests/test_nonlinearsolver.cpp
   tests/test_invert.cpp
+  tests/test_cellcostpartitioning.cpp
+  tests/test_performancetimers.cpp
+  tests/test_linearsystemsnapshot.cpp
   tests/test_stoppedwells.cpp
   tests/test_relpermdiagnostics.cpp
   tests/test_norne_pvt.cpp
+  tests/test_saturatedpvtbatch.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
   tests/test_parallelwellinfo.cpp
   tests/test_glift1.cpp
+  tests/test_wellpotentials.cpp
   tests/test_keyword_validator.cpp
   tests/test_GroupState.cpp
   tests/test_ALQState.cpp
   )
 
 if(MPI_FOUND)
-  list(APPEND TEST_SOURCE_FILES tests/test_parallelistlinformation.cpp
+  list(APPEND TEST_SOURCE_FILES tests/test_deckcache.cpp
+                                tests/test_parallelistlinformation.cpp
                                 tests/test_ParallelRestart.cpp)
 endif()
 if(CUDA_FOUND)
@@ -176,6 +190,9 @@ list (APPEND TEST_DATA_FILES
   tests/equil_capillary_swatinit.DATA
   tests/equil_deadfluids.DATA
   tests/equil_pbvd_and_pdvd.DATA
+  tests/transmultipliers.DATA
+  tests/transmultipliers_editnnc.DATA
+  tests/timesteprollback.DATA
   tests/VFPPROD1
   tests/VFPPROD2
   tests/msw.data
@@ -198,6 +215,7 @@ list (APPEND TEST_DATA_FILES
   tests/wells_stopped.data
   tests/relpermDiagnostics.DATA
   tests/norne_pvt.data
+  tests/saturatedpvt.DATA
   tests/wells_no_perforation.data
   tests/matr33.txt
   tests/rhs3.txt
@@ -206,6 +224,7 @@ list (APPEND TEST_DATA_FILES
   tests/options_flexiblesolver.json
   tests/options_flexiblesolver_simple.json
   tests/GLIFT1.DATA
+  tests/wellpotentials.DATA
   tests/include/flowl_b_vfp.ecl
   tests/include/flowl_c_vfp.ecl
   tests/include/permx_model5.grdecl
@@ -227,6 +246,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/FlowMainEbos.hpp
   opm/simulators/flow/Main.hpp
   opm/simulators/flow/NonlinearSolverEbos.hpp
+  opm/simulators/flow/SimulatorCheckpoint.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/KeywordValidation.hpp
   opm/core/props/BlackoilPhases.hpp
@@ -235,6 +255,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/timestepping/SimulatorReport.hpp
   opm/simulators/wells/SegmentState.hpp
   opm/simulators/wells/WellContainer.hpp
+  opm/simulators/wells/WellPhaseContainer.hpp
   opm/simulators/aquifers/AquiferInterface.hpp
   opm/simulators/aquifers/AquiferCarterTracy.hpp
   opm/simulators/aquifers/AquiferFetkovich.hpp
@@ -270,6 +291,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/GraphColoring.hpp
   opm/simulators/linalg/ISTLSolverEbos.hpp
   opm/simulators/linalg/ISTLSolverEbosFlexible.hpp
+  opm/simulators/linalg/LinearSystemSnapshot.hpp
   opm/simulators/linalg/MatrixBlock.hpp
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
   opm/simulators/linalg/OwningBlockPreconditioner.hpp
@@ -295,13 +317,16 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/timestepping/SimulatorTimer.hpp
   opm/simulators/timestepping/SimulatorTimerInterface.hpp
   opm/simulators/timestepping/gatherConvergenceReport.hpp
+  opm/simulators/utils/CellCostPartitioning.hpp
   opm/simulators/utils/ParallelFileMerger.hpp
   opm/simulators/utils/DeferredLoggingErrorHelpers.hpp
+  opm/simulators/utils/DeckCache.hpp
   opm/simulators/utils/DeferredLogger.hpp
   opm/simulators/utils/gatherDeferredLogger.hpp
   opm/simulators/utils/moduleVersion.hpp
   opm/simulators/utils/ParallelEclipseState.hpp
   opm/simulators/utils/ParallelRestart.hpp
+  opm/simulators/utils/PerformanceTimers.hpp
   opm/simulators/utils/PropsCentroidsDataHandle.hpp
   opm/simulators/wells/PerfData.hpp
   opm/simulators/wells/PerforationData.hpp
@@ -312,6 +337,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/WellState.hpp
   opm/simulators/wells/GlobalWellInfo.hpp
   opm/simulators/wells/GroupState.hpp
+  opm/simulators/wells/GroupTree.hpp
   opm/simulators/wells/ALQState.hpp
   opm/simulators/wells/WGState.hpp
   opm/simulators/wells/VFPProperties.hpp
@@ -335,4 +361,5 @@ list (APPEND PUBLIC_HEADER_FILES
 
 list (APPEND EXAMPLE_SOURCE_FILES
   examples/printvfp.cpp
+  examples/replaylinearsystem.cpp
   )
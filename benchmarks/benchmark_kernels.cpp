@@ -0,0 +1,522 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Time the kernels that dominate the run time of flow, so that performance
+// regressions in them can be caught and quantified.
+//
+// Usage: benchmark_kernels [--deck=<file>] [--size=<n>] [--samples=<n>]
+//                          [--min-sample-time=<seconds>] [--filter=<text>]
+//
+// The linear algebra kernels and the VFP interpolation run on synthetic
+// input: a 7-point system with 3x3 blocks on a <n>^3 grid and a VFPPROD
+// table of 10^4 * 20 points. The kernels that need a model, i.e. the well
+// assembly and application, the transmissibility update, the equilibration
+// and the serialization of the input, run on the given deck, for instance
+// tests/TESTWELLMODEL.DATA, and are skipped without one. Only the kernels
+// whose name contains <text> are run.
+//
+// Each kernel is warmed up and then timed in a number of samples. A sample
+// calls the kernel as often as needed to take at least the minimum sample
+// time, so the resolution of the clock does not show in the results for the
+// short kernels. The median of the samples is reported as the time of a
+// call, with the minimum and the relative spread of the samples. On several
+// processes, the slowest process is reported.
+
+#include <config.h>
+
+#include <ebos/eclmpiserializer.hh>
+#include <ebos/equil/equilibrationhelpers.hh>
+#include <ebos/equil/initstateequil.hh>
+
+#include <opm/models/utils/start.hh>
+
+#include <opm/parser/eclipse/EclipseState/InitConfig/Equil.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+
+#include <opm/simulators/flow/BlackoilModelEbos.hpp>
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/setupPropertyTree.hpp>
+#include <opm/simulators/utils/ParallelEclipseState.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+struct BenchmarkOptions
+{
+    std::string deck;
+    std::string filter;
+    int size = 40;
+    int samples = 20;
+    double minSampleTime = 0.01;
+};
+
+// Keeps the results of the timed kernels alive, so that the compiler cannot
+// drop the calls.
+volatile double sink = 0.0;
+
+template <class Comm>
+class Benchmark
+{
+public:
+    Benchmark(const Comm& comm, const BenchmarkOptions& options)
+        : comm_(comm)
+        , options_(options)
+    {
+        if (comm_.rank() == 0) {
+            std::cout << fmt::format("{:<28} {:>8} {:>12} {:>12} {:>9}\n",
+                                     "Kernel", "calls", "median [s]", "min [s]", "spread");
+        }
+    }
+
+    bool enabled(const std::string& name) const
+    {
+        return name.find(options_.filter) != std::string::npos;
+    }
+
+    bool anyEnabled(const std::vector<std::string>& names) const
+    {
+        return std::any_of(names.begin(), names.end(),
+                           [this](const std::string& name) { return enabled(name); });
+    }
+
+    //! \brief Time a kernel and print the statistics of the samples.
+    //! \details The kernel is called the same number of times on all
+    //!          processes, so it may communicate.
+    void run(const std::string& name, const std::function<void()>& kernel)
+    {
+        if (!enabled(name)) {
+            return;
+        }
+
+        // Warm up the caches and the allocations of the kernel, and find
+        // how many calls make up a sample.
+        kernel();
+        const double first = time(kernel, 1);
+        const long calls = comm_.max(std::max(1L, static_cast<long>(std::ceil(options_.minSampleTime
+                                                                              / std::max(first, 1e-9)))));
+        time(kernel, calls);
+
+        std::vector<double> samples;
+        for (int sample = 0; sample < options_.samples; ++sample) {
+            samples.push_back(time(kernel, calls) / calls);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        const auto n = samples.size();
+        const double median = n % 2 ? samples[n/2] : 0.5 * (samples[n/2 - 1] + samples[n/2]);
+        double mean = 0.0;
+        for (const double s : samples) {
+            mean += s;
+        }
+        mean /= n;
+        double variance = 0.0;
+        for (const double s : samples) {
+            variance += (s - mean) * (s - mean);
+        }
+        variance /= std::max<std::size_t>(n - 1, 1);
+        const double spread = mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+
+        const double slowestMedian = comm_.max(median);
+        const double slowestMin = comm_.max(samples.front());
+        const double largestSpread = comm_.max(spread);
+        if (comm_.rank() == 0) {
+            std::cout << fmt::format("{:<28} {:>8} {:>12.4e} {:>12.4e} {:>8.1f}%\n",
+                                     name, calls, slowestMedian, slowestMin, 100.0 * largestSpread);
+        }
+    }
+
+private:
+    static double time(const std::function<void()>& kernel, const long calls)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (long call = 0; call < calls; ++call) {
+            kernel();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const Comm& comm_;
+    const BenchmarkOptions& options_;
+};
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 3, 3>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+
+// A 7-point stencil on an n^3 grid with diagonally dominant 3x3 blocks, in
+// which the first (pressure) equation couples to all unknowns of the
+// neighbours, as in a linearized black-oil system.
+Matrix sevenPointMatrix(const int n)
+{
+    const int numCells = n * n * n;
+    Matrix matrix(numCells, numCells, 7 * numCells, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        const int cell = row.index();
+        const int i = cell % n;
+        const int j = (cell / n) % n;
+        const int k = cell / (n * n);
+        if (k > 0)     { row.insert(cell - n * n); }
+        if (j > 0)     { row.insert(cell - n); }
+        if (i > 0)     { row.insert(cell - 1); }
+        row.insert(cell);
+        if (i < n - 1) { row.insert(cell + 1); }
+        if (j < n - 1) { row.insert(cell + n); }
+        if (k < n - 1) { row.insert(cell + n * n); }
+    }
+
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            auto& block = *col;
+            block = 0.0;
+            if (col.index() == row.index()) {
+                for (int r = 0; r < 3; ++r) {
+                    for (int c = 0; c < 3; ++c) {
+                        block[r][c] = r == c ? 7.0 : 0.1;
+                    }
+                }
+            } else {
+                for (int r = 0; r < 3; ++r) {
+                    block[r][r] = -1.0;
+                }
+                block[0][1] = -0.05;
+                block[0][2] = -0.05;
+            }
+        }
+    }
+    return matrix;
+}
+
+template <class Comm>
+void benchmarkLinearAlgebra(Benchmark<Comm>& benchmark, const BenchmarkOptions& options)
+{
+    if (!benchmark.anyEnabled({"ilu0 update", "ilu0 apply", "cpr setup", "cpr apply"})) {
+        return;
+    }
+
+    const Matrix matrix = sevenPointMatrix(options.size);
+    Vector rhs(matrix.N());
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        rhs[i] = 1.0 + 0.001 * (i % 97);
+    }
+    Vector x(matrix.N());
+
+    if (benchmark.anyEnabled({"ilu0 update", "ilu0 apply"})) {
+        Opm::ParallelOverlappingILU0<Matrix, Vector, Vector> ilu(matrix, 0, 1.0, Opm::MILU_VARIANT::ILU);
+        benchmark.run("ilu0 update", [&ilu]() { ilu.update(); });
+        benchmark.run("ilu0 apply", [&ilu, &x, &rhs]() { x = 0.0; ilu.apply(x, rhs); });
+    }
+
+    if (benchmark.anyEnabled({"cpr setup", "cpr apply"})) {
+        using Operator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+        using Solver = Dune::FlexibleSolver<Matrix, Vector>;
+        const std::size_t pressureIndex = 0;
+        Operator op(matrix);
+        const auto prm = Opm::setupCPR("cpr", Opm::FlowLinearSolverParameters());
+        std::function<Vector()> weightsCalculator = [&matrix, pressureIndex]() {
+            return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(matrix, pressureIndex, /*transpose=*/false);
+        };
+        Solver solver(op, prm, weightsCalculator, pressureIndex);
+        auto& preconditioner = solver.preconditioner();
+        benchmark.run("cpr setup", [&preconditioner]() { preconditioner.update(); });
+        benchmark.run("cpr apply", [&preconditioner, &x, &rhs]() { x = 0.0; preconditioner.apply(x, rhs); });
+    }
+}
+
+template <class Comm>
+void benchmarkVfp(Benchmark<Comm>& benchmark)
+{
+    const std::string name = "vfp bhp (1000 points)";
+    if (!benchmark.enabled(name)) {
+        return;
+    }
+
+    auto axis = [](const int n, const double last) {
+        std::vector<double> values(n);
+        for (int i = 0; i < n; ++i) {
+            values[i] = last * i / (n - 1);
+        }
+        return values;
+    };
+    const auto flo = axis(20, 1000.0);
+    const auto thp = axis(10, 100.0e5);
+    const auto wfr = axis(10, 2.0);
+    const auto gfr = axis(10, 500.0);
+    const auto alq = axis(10, 1.0e5);
+
+    // The values are ordered as [thp][wfr][gfr][alq][flo]. Like those of a
+    // real table, they increase with the rate, the pressure and the ratios
+    // and decrease with the lift.
+    std::vector<double> data;
+    data.reserve(thp.size() * wfr.size() * gfr.size() * alq.size() * flo.size());
+    for (const double t : thp) {
+        for (const double w : wfr) {
+            for (const double g : gfr) {
+                for (const double a : alq) {
+                    for (const double f : flo) {
+                        data.push_back(t + 1.0e5 * (50.0 + 10.0 * w + 0.01 * g - 1.0e-4 * a + 0.02 * f));
+                    }
+                }
+            }
+        }
+    }
+    const Opm::VFPProdTable table(1, 1000.0,
+                                  Opm::VFPProdTable::FLO_TYPE::FLO_OIL,
+                                  Opm::VFPProdTable::WFR_TYPE::WFR_WOR,
+                                  Opm::VFPProdTable::GFR_TYPE::GFR_GOR,
+                                  Opm::VFPProdTable::ALQ_TYPE::ALQ_UNDEF,
+                                  flo, thp, wfr, gfr, alq, data);
+    Opm::VFPProdProperties properties;
+    properties.addTable(table);
+
+    // Evaluate at points scattered over the table, to include the search
+    // for the interval along each axis.
+    struct Point { double aqua, liquid, vapour, thp, alq; };
+    std::vector<Point> points;
+    unsigned long random = 42;
+    auto next = [&random]() {
+        random = random * 1103515245 + 12345;
+        return static_cast<double>((random >> 16) % 10000) / 10000.0;
+    };
+    for (int i = 0; i < 1000; ++i) {
+        const double liquid = 10.0 + 980.0 * next();
+        points.push_back({2.0 * next() * liquid, liquid, 500.0 * next() * liquid,
+                          100.0e5 * next(), 1.0e5 * next()});
+    }
+
+    benchmark.run(name, [&properties, &points]() {
+        double sum = 0.0;
+        for (const auto& p : points) {
+            sum += properties.bhp(1, p.aqua, p.liquid, p.vapour, p.thp, p.alq);
+        }
+        sink = sum;
+    });
+}
+
+// The input that is broadcast from the first process at the start of a run.
+struct BroadcastInput
+{
+    Opm::EclipseState& eclState;
+    Opm::Schedule& schedule;
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        eclState.serializeOp(serializer);
+        schedule.serializeOp(serializer);
+    }
+};
+
+template <class Comm>
+void benchmarkModel(Benchmark<Comm>& benchmark, const BenchmarkOptions& options, const std::string& program)
+{
+    using TypeTag = Opm::Properties::TTag::EclFlowProblem;
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+    using Vanguard = Opm::GetPropType<TypeTag, Opm::Properties::Vanguard>;
+    using FluidSystem = Opm::GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+
+    std::vector<std::string> arguments{program,
+                                       "--ecl-deck-file-name=" + options.deck,
+                                       "--enable-ecl-output=false"};
+    std::vector<char*> args;
+    for (auto& argument : arguments) {
+        args.push_back(argument.data());
+    }
+    if (Opm::FlowMainEbos<TypeTag>::setupParameters_(static_cast<int>(args.size()), args.data()) != EXIT_SUCCESS) {
+        throw std::invalid_argument("Could not set up the simulator for " + options.deck);
+    }
+    auto simulator = std::make_unique<Simulator>();
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(43200);
+    simulator->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    auto& vanguard = simulator->vanguard();
+
+    if (benchmark.anyEnabled({"well assemble", "well apply"})) {
+        auto& wellModel = simulator->problem().wellModel();
+        simulator->model().newtonMethod().setIterationIndex(0);
+        wellModel.beginReportStep(0);
+        wellModel.beginTimeStep();
+        wellModel.beginIteration();
+
+        // Later Newton iterations only assemble the well equations.
+        simulator->model().newtonMethod().setIterationIndex(1);
+        benchmark.run("well assemble", [&wellModel]() { wellModel.beginIteration(); });
+
+        using BVector = typename std::remove_reference_t<decltype(wellModel)>::BVector;
+        BVector x(simulator->model().numGridDof());
+        BVector Ax(x.size());
+        x = 1.0;
+        benchmark.run("well apply", [&wellModel, &x, &Ax]() { Ax = 0.0; wellModel.apply(x, Ax); });
+    }
+
+    if (benchmark.enabled("transmissibility update")) {
+        typename Vanguard::TransmissibilityType transmissibilities(vanguard.eclState(),
+                                                                   vanguard.gridView(),
+                                                                   vanguard.cartesianIndexMapper(),
+                                                                   vanguard.grid(),
+                                                                   vanguard.cellCentroids(),
+                                                                   /*enableEnergy=*/false,
+                                                                   /*enableDiffusivity=*/false);
+        benchmark.run("transmissibility update", [&transmissibilities]() {
+            transmissibilities.update(/*global=*/true);
+        });
+    }
+
+    if (benchmark.enabled("pressure table")) {
+        const auto& gridView = vanguard.gridView();
+        std::vector<std::pair<double, double>> cellZMinMax;
+        std::vector<int> cells;
+        for (const auto& element : elements(gridView)) {
+            cells.push_back(static_cast<int>(cellZMinMax.size()));
+            cellZMinMax.push_back(Opm::EQUIL::Details::cellZMinMax(element));
+        }
+        std::array<double, 2> span{};
+        Opm::EQUIL::Details::verticalExtent(cells, cellZMinMax, gridView.comm(), span);
+
+        // Contacts at a quarter and three quarters of the depth, so that all
+        // active phases have a zone of their own.
+        const double height = span[1] - span[0];
+        const Opm::EquilRecord record(span[0], 200.0e5,
+                                      span[0] + 0.75 * height, 0.0,
+                                      span[0] + 0.25 * height, 0.0,
+                                      true, true, 0);
+        const std::vector<double> depth{span[0], span[1]};
+        const std::vector<double> salt{0.0, 0.0};
+        const Opm::EQUIL::EquilReg region(record,
+                                          std::make_shared<Opm::EQUIL::Miscibility::NoMixing>(),
+                                          std::make_shared<Opm::EQUIL::Miscibility::NoMixing>(),
+                                          Opm::Tabulated1DFunction<double>(2, depth, salt),
+                                          0);
+        const double gravity = simulator->problem().gravity()[Vanguard::Grid::dimensionworld - 1];
+        benchmark.run("pressure table", [&region, &span, gravity]() {
+            Opm::EQUIL::Details::PressureTable<FluidSystem, Opm::EQUIL::EquilReg> table(gravity);
+            table.equilibrate(region, span);
+            sink = table.oil(0.5 * (span[0] + span[1]));
+        });
+    }
+
+    if (benchmark.anyEnabled({"serializer pack", "serializer unpack"})) {
+        BroadcastInput input{vanguard.eclState(), vanguard.schedule()};
+        Opm::EclMpiSerializer serializer(Dune::MPIHelper::getCollectiveCommunication());
+        benchmark.run("serializer pack", [&serializer, &input]() { serializer.pack(input); });
+
+        // Unpack from the buffer of the last pack, into new objects like
+        // the other processes of a run.
+        serializer.pack(input);
+        auto python = std::make_shared<Opm::Python>();
+        benchmark.run("serializer unpack", [&serializer, &python]() {
+            Opm::ParallelEclipseState eclState;
+            Opm::Schedule schedule(python);
+            BroadcastInput output{eclState, schedule};
+            serializer.unpack(output);
+        });
+    }
+}
+
+BenchmarkOptions parseOptions(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&arg](const std::string& name) {
+            return arg.rfind(name, 0) == 0 ? arg.substr(name.size()) : std::string();
+        };
+        if (!value("--deck=").empty()) {
+            options.deck = value("--deck=");
+        } else if (!value("--filter=").empty()) {
+            options.filter = value("--filter=");
+        } else if (!value("--size=").empty()) {
+            options.size = std::max(2, std::stoi(value("--size=")));
+        } else if (!value("--samples=").empty()) {
+            options.samples = std::max(1, std::stoi(value("--samples=")));
+        } else if (!value("--min-sample-time=").empty()) {
+            options.minSampleTime = std::max(0.0, std::stod(value("--min-sample-time=")));
+        } else {
+            throw std::invalid_argument("Unknown argument " + arg);
+        }
+    }
+    return options;
+}
+
+} // Anonymous namespace
+
+
+int main(int argc, char** argv)
+{
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+    Dune::MPIHelper::instance(argc, argv);
+#endif
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    try {
+        const auto options = parseOptions(argc, argv);
+        Benchmark<std::remove_cv_t<std::remove_reference_t<decltype(comm)>>> benchmark(comm, options);
+
+        benchmarkLinearAlgebra(benchmark, options);
+        benchmarkVfp(benchmark);
+        if (!options.deck.empty()) {
+            benchmarkModel(benchmark, options, argv[0]);
+        } else if (comm.rank() == 0) {
+            std::cout << "No deck given, skipping the well, transmissibility, "
+                      << "equilibration and serialization kernels\n";
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
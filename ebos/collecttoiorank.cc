@@ -27,6 +27,7 @@
 #include <opm/grid/common/CartesianIndexMapper.hpp>
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/polyhedralgrid.hh>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 
 #include <dune/common/version.hh>
 #include <dune/grid/common/gridenums.hh>
@@ -844,6 +845,8 @@ collect(const data::Solution& localCellData,
         const data::GroupAndNetworkValues& localGroupAndNetworkData,
         const data::Aquifers& localAquiferData)
 {
+    ScopedPerformanceTimer timer(PerformanceTimers::OutputCollection);
+
     globalCellData_ = {};
     globalBlockData_.clear();
     globalWBPData_.clear();
@@ -76,6 +76,14 @@ struct EclOutputInterval {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct DeckCache {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NodeSharedBroadcast {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct IgnoreKeywords {
     using type = UndefinedProperty;
 };
@@ -103,6 +111,31 @@ struct AllowDistributedWells {
     using type = UndefinedProperty;
 };
 
+template<class TypeTag, class MyTypeTag>
+struct PartitionCellCosts {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct PartitionCostConnection {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct PartitionCostPerforation {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct PartitionCostMultisegmentPerforation {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct PartitionCostAquiferConnection {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct PartitionCostStatisticsFile {
+    using type = UndefinedProperty;
+};
+
 template<class TypeTag>
 struct IgnoreKeywords<TypeTag, TTag::EclBaseVanguard> {
     static constexpr auto value = "";
@@ -116,6 +149,14 @@ struct EclOutputInterval<TypeTag, TTag::EclBaseVanguard> {
     static constexpr int value = -1;
 };
 template<class TypeTag>
+struct DeckCache<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "";
+};
+template<class TypeTag>
+struct NodeSharedBroadcast<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct EnableOpmRstFile<TypeTag, TTag::EclBaseVanguard> {
     static constexpr bool value = false;
 };
@@ -150,6 +191,31 @@ struct AllowDistributedWells<TypeTag, TTag::EclBaseVanguard> {
     static constexpr bool value = false;
 };
 
+template<class TypeTag>
+struct PartitionCellCosts<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct PartitionCostConnection<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr double value = 0.1;
+};
+template<class TypeTag>
+struct PartitionCostPerforation<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr double value = 4.0;
+};
+template<class TypeTag>
+struct PartitionCostMultisegmentPerforation<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr double value = 4.0;
+};
+template<class TypeTag>
+struct PartitionCostAquiferConnection<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr double value = 1.0;
+};
+template<class TypeTag>
+struct PartitionCostStatisticsFile<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "";
+};
+
 template<class T1, class T2>
 struct UseMultisegmentWell;
 
@@ -199,6 +265,10 @@ public:
                              "The name of the file which contains the ECL deck to be simulated");
         EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputInterval,
                              "The number of report steps that ought to be skipped between two writes of ECL results");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, DeckCache,
+                             "Binary cache of the parsed input. Loaded instead of parsing the deck if the input files are unchanged, written otherwise");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, NodeSharedBroadcast,
+                             "Broadcast the parsed input once per node and let the processes of a node unpack it from one shared memory buffer. Every process still holds its own copy of the unpacked input");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableOpmRstFile,
                              "Include OPM-specific keywords in the ECL restart file to enable restart of OPM simulators from these files");
         EWOMS_REGISTER_PARAM(TypeTag, std::string, IgnoreKeywords,
@@ -217,6 +287,18 @@ public:
                              "Tolerable imbalance of the loadbalancing provided by Zoltan (default: 1.1).");
         EWOMS_REGISTER_PARAM(TypeTag, bool, AllowDistributedWells,
                              "Allow the perforations of a well to be distributed to interior of multiple processes");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, PartitionCellCosts,
+                             "Partition the grid by the estimated cost of the cells instead of using Zoltan");
+        EWOMS_REGISTER_PARAM(TypeTag, double, PartitionCostConnection,
+                             "Cost of a connection to another cell, relative to the cost of a cell");
+        EWOMS_REGISTER_PARAM(TypeTag, double, PartitionCostPerforation,
+                             "Cost of a well perforation, relative to the cost of a cell");
+        EWOMS_REGISTER_PARAM(TypeTag, double, PartitionCostMultisegmentPerforation,
+                             "Additional cost of a perforation of a multisegment well, relative to the cost of a cell");
+        EWOMS_REGISTER_PARAM(TypeTag, double, PartitionCostAquiferConnection,
+                             "Cost of a connection to an analytical aquifer, relative to the cost of a cell");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, PartitionCostStatisticsFile,
+                             "File with the cost statistics of the processes. If it exists, the costs are fitted to it before partitioning. It is rewritten at the report steps whose load imbalance exceeds LoadImbalanceThreshold, or at the end of the run if there is no such step");
         // register here for the use in the tests without BlackoildModelParametersEbos
         EWOMS_REGISTER_PARAM(TypeTag, bool, UseMultisegmentWell, "Use the well model for multi-segment wells instead of the one for single-segment wells");
 
@@ -237,11 +319,19 @@ public:
         serialPartitioning_ = EWOMS_GET_PARAM(TypeTag, bool, SerialPartitioning);
         zoltanImbalanceTol_ = EWOMS_GET_PARAM(TypeTag, double, ZoltanImbalanceTol);
         enableDistributedWells_ = EWOMS_GET_PARAM(TypeTag, bool, AllowDistributedWells);
+        partitionCellCosts_ = EWOMS_GET_PARAM(TypeTag, bool, PartitionCellCosts);
+        cellCostCoefficients_.connection = EWOMS_GET_PARAM(TypeTag, double, PartitionCostConnection);
+        cellCostCoefficients_.perforation = EWOMS_GET_PARAM(TypeTag, double, PartitionCostPerforation);
+        cellCostCoefficients_.msPerforation = EWOMS_GET_PARAM(TypeTag, double, PartitionCostMultisegmentPerforation);
+        cellCostCoefficients_.aquiferConnection = EWOMS_GET_PARAM(TypeTag, double, PartitionCostAquiferConnection);
+        cellCostStatisticsFile_ = EWOMS_GET_PARAM(TypeTag, std::string, PartitionCostStatisticsFile);
         ignoredKeywords_ = EWOMS_GET_PARAM(TypeTag, std::string, IgnoreKeywords);
         eclStrictParsing_ = EWOMS_GET_PARAM(TypeTag, bool, EclStrictParsing);
         int output_param = EWOMS_GET_PARAM(TypeTag, int, EclOutputInterval);
         if (output_param >= 0)
             outputInterval_ = output_param;
+        deckCacheFile_ = EWOMS_GET_PARAM(TypeTag, std::string, DeckCache);
+        nodeSharedBroadcast_ = EWOMS_GET_PARAM(TypeTag, bool, NodeSharedBroadcast);
         useMultisegmentWell_ = EWOMS_GET_PARAM(TypeTag, bool, UseMultisegmentWell);
         enableExperiments_ = enableExperiments;
 
@@ -385,6 +475,64 @@ public:
         return grid.comm().sum(local_cells);
     }
 
+    /*!
+     * \brief Write the cost statistics of all processes to the file given by
+     *        the PartitionCostStatisticsFile parameter, if any.
+     *
+     * \param seconds The time this process has spent on the work that scales
+     *                with its cells.
+     * \warn This is a collective operation that needs to be called
+     * on all ranks.
+     */
+    void writeCellCostStatistics(double seconds) const
+    {
+        if (this->cellCostStatisticsFile().empty())
+            return;
+
+        const auto& gridView = this->gridView();
+        const int numCells = gridView.size(/*codim=*/0);
+        std::vector<int> cartIdx(numCells);
+        std::vector<int> numNeighbours(numCells, 0);
+        std::vector<bool> interior(numCells, false);
+
+        ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const Element& element = *elemIt;
+            const unsigned int elemIdx = elemMapper.index(element);
+            cartIdx[elemIdx] = cartesianIndex(elemIdx);
+            interior[elemIdx] = element.partitionType() == Dune::InteriorEntity;
+            auto isIt = gridView.ibegin(element);
+            const auto& isEndIt = gridView.iend(element);
+            for (; isIt != isEndIt; ++isIt) {
+                if (isIt->neighbor())
+                    ++numNeighbours[elemIdx];
+            }
+        }
+
+        const auto features = cellCostFeatures(cartIdx, numNeighbours,
+                                               this->eclState(), this->schedule());
+        const auto local = cellCostStatistics(features, interior, seconds);
+
+        const auto& comm = asImp_().grid().comm();
+        constexpr int numValues = 6;
+        const std::array<double, numValues> localValues{local.cells, local.connections,
+                                                        local.perforations, local.msPerforations,
+                                                        local.aquiferConnections, local.seconds};
+        std::vector<double> values(comm.rank() == 0 ? numValues * comm.size() : 0);
+        comm.gather(localValues.data(), values.data(), numValues, 0);
+
+        if (comm.rank() == 0) {
+            std::vector<CellCostStatistics> statistics(comm.size());
+            for (int rank = 0; rank < comm.size(); ++rank) {
+                const double* v = values.data() + numValues * rank;
+                statistics[rank] = {v[0], v[1], v[2], v[3], v[4], v[5]};
+            }
+            Opm::writeCellCostStatistics(this->cellCostStatisticsFile(), statistics);
+        }
+    }
+
 protected:
     void callImplementationInit()
     {
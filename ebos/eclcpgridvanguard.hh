@@ -133,7 +133,9 @@ public:
 #if HAVE_MPI
         this->doLoadBalance_(this->edgeWeightsMethod(), this->ownersFirst(),
                              this->serialPartitioning(), this->enableDistributedWells(),
-                             this->zoltanImbalanceTol(), this->gridView(),
+                             this->zoltanImbalanceTol(), this->partitionCellCosts(),
+                             this->cellCostCoefficients(), this->cellCostStatisticsFile(),
+                             this->gridView(),
                              this->schedule(), this->centroids_,
                              this->eclState(), this->parallelWells_);
 #endif
@@ -46,6 +46,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <numeric>
 #include <sstream>
@@ -78,6 +80,9 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
                                                                              bool serialPartitioning,
                                                                              bool enableDistributedWells,
                                                                              double zoltanImbalanceTol,
+                                                                             bool partitionCellCosts,
+                                                                             const CellCostCoefficients& cellCostCoefficients,
+                                                                             const std::string& cellCostStatisticsFile,
                                                                              const GridView& gridv,
                                                                              const Schedule& schedule,
                                                                              std::vector<double>& centroids,
@@ -106,7 +111,9 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
         std::vector<double> faceTrans;
         int loadBalancerSet = externalLoadBalancer.has_value();
         grid_->comm().broadcast(&loadBalancerSet, 1, 0);
-        if (!loadBalancerSet){
+        // The cost partitioning replaces Zoltan, but not an external load balancer.
+        partitionCellCosts = partitionCellCosts && !loadBalancerSet;
+        if (!loadBalancerSet && !partitionCellCosts){
             faceTrans.resize(numFaces, 0.0);
             ElementMapper elemMapper(gridv, Dune::mcmgElementLayout());
             auto elemIt = gridView.template begin</*codim=*/0>();
@@ -147,12 +154,16 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
 
                 PropsCentroidsDataHandle<Dune::CpGrid> handle(*grid_, eclState, eclGrid, centroids,
                                                               cartesianIndexMapper());
-                if (loadBalancerSet)
+                if (loadBalancerSet || partitionCellCosts)
                 {
                     std::vector<int> parts;
                     if (grid_->comm().rank() == 0)
                     {
-                        parts =  (*externalLoadBalancer)(*grid_);
+                        if (loadBalancerSet)
+                            parts =  (*externalLoadBalancer)(*grid_);
+                        else
+                            parts = this->partitionCellCosts_(cellCostCoefficients, cellCostStatisticsFile,
+                                                              gridv, eclState, schedule);
                     }
                     parallelWells = std::get<1>(grid_->loadBalance(handle, parts, &wells, ownersFirst, false, 1));
                 }
@@ -184,6 +195,74 @@ void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::doLoadBalance_(Dun
     }
 }
 
+template<class ElementMapper, class GridView, class Scalar>
+std::vector<int> EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::
+partitionCellCosts_(CellCostCoefficients coefficients,
+                    const std::string& statisticsFile,
+                    const GridView& gridv,
+                    const EclipseState& eclState,
+                    const Schedule& schedule) const
+{
+    if (!statisticsFile.empty()) {
+        const auto statistics = readCellCostStatistics(statisticsFile);
+        if (!statistics.empty()) {
+            coefficients = calibrateCellCosts(statistics, coefficients);
+            OpmLog::info(fmt::format("Cell costs fitted to the statistics of {} processes in {}: "
+                                     "connection {:.3g}, perforation {:.3g}, multisegment perforation {:.3g}, "
+                                     "aquifer connection {:.3g}",
+                                     statistics.size(), statisticsFile, coefficients.connection,
+                                     coefficients.perforation, coefficients.msPerforation,
+                                     coefficients.aquiferConnection));
+        }
+    }
+
+    const auto& gridView = grid_->leafGridView();
+    const auto& idSet = grid_->localIdSet();
+    const int numCells = gridView.size(/*codim=*/0);
+    std::vector<int> cartIdx(numCells);
+    std::vector<int> numNeighbours(numCells, 0);
+    std::vector<std::array<double, 3>> cellCentroids(numCells);
+    std::vector<int> cellId(numCells);
+
+    ElementMapper elemMapper(gridv, Dune::mcmgElementLayout());
+    auto elemIt = gridView.template begin</*codim=*/0>();
+    const auto& elemEndIt = gridView.template end</*codim=*/0>();
+    for (; elemIt != elemEndIt; ++ elemIt) {
+        const auto& elem = *elemIt;
+        const unsigned elemIdx = elemMapper.index(elem);
+        cartIdx[elemIdx] = cartesianIndexMapper_->cartesianIndex(elemIdx);
+        cellId[elemIdx] = idSet.id(elem);
+        const auto center = elem.geometry().center();
+        for (int d = 0; d < 3; ++d)
+            cellCentroids[elemIdx][d] = center[d];
+
+        auto isIt = gridView.ibegin(elem);
+        const auto& isEndIt = gridView.iend(elem);
+        for (; isIt != isEndIt; ++ isIt) {
+            if (isIt->neighbor())
+                ++numNeighbours[elemIdx];
+        }
+    }
+
+    const auto costs = cellCosts(cellCostFeatures(cartIdx, numNeighbours, eclState, schedule),
+                                 coefficients);
+    const int numParts = grid_->comm().size();
+    const auto cellParts = partitionCellsByCost(cellCentroids, costs,
+                                                wellCells(cartIdx, schedule), numParts);
+
+    std::vector<int> parts(numCells);
+    std::vector<double> partCost(numParts, 0.0);
+    for (int cell = 0; cell < numCells; ++cell) {
+        parts[cellId[cell]] = cellParts[cell];
+        partCost[cellParts[cell]] += costs[cell];
+    }
+    const double maxCost = *std::max_element(partCost.begin(), partCost.end());
+    const double meanCost = std::accumulate(partCost.begin(), partCost.end(), 0.0) / numParts;
+    OpmLog::info(fmt::format("Partitioned the grid by cell costs, maximum/mean cost per process: {:.3f}",
+                             meanCost > 0.0 ? maxCost / meanCost : 1.0));
+    return parts;
+}
+
 template<class ElementMapper, class GridView, class Scalar>
 void EclGenericCpGridVanguard<ElementMapper,GridView,Scalar>::distributeFieldProps_(EclipseState& eclState1)
 {
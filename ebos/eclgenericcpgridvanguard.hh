@@ -111,12 +111,25 @@ protected:
     void doLoadBalance_(Dune::EdgeWeightMethod edgeWeightsMethod,
                         bool ownersFirst, bool serialPartitioning,
                         bool enableDistributedWells, double zoltanImbalanceTol,
+                        bool partitionCellCosts,
+                        const CellCostCoefficients& cellCostCoefficients,
+                        const std::string& cellCostStatisticsFile,
                         const GridView& gridv, const Schedule& schedule,
                         std::vector<double>& centroids,
                         EclipseState& eclState,
                         EclGenericVanguard::ParallelWellStruct& parallelWells);
 
     void distributeFieldProps_(EclipseState& eclState);
+
+    /*!
+     * \brief Partition the cells of the (undistributed) grid by their
+     *        estimated cost, keeping the cells of a well together.
+     */
+    std::vector<int> partitionCellCosts_(CellCostCoefficients coefficients,
+                                         const std::string& statisticsFile,
+                                         const GridView& gridv,
+                                         const EclipseState& eclState,
+                                         const Schedule& schedule) const;
 #endif
 
     void allocCartMapper();
@@ -31,6 +31,7 @@
 #include <opm/material/common/UniformXTabulated2DFunction.hpp>
 #include <opm/material/common/Tabulated1DFunction.hpp>
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -129,6 +130,23 @@ public:
     void setPorosity(Scalar poro, unsigned elementIdx, unsigned timeIdx = 0)
     { referencePorosity_[timeIdx][elementIdx] = poro; }
 
+    /*!
+     * \brief Returns the reference porosity of all elements
+     */
+    const std::vector<Scalar>& referencePorosities(unsigned timeIdx) const
+    { return referencePorosity_[timeIdx]; }
+
+    /*!
+     * \brief Sets the porosity of all elements
+     *
+     * \param poro Array with one value per element
+     */
+    void setPorosities(const Scalar* poro, unsigned timeIdx = 0)
+    {
+        std::copy_n(poro, referencePorosity_[timeIdx].size(),
+                    referencePorosity_[timeIdx].begin());
+    }
+
     /*!
      * \brief Returns the initial solvent saturation for a given a cell index
      */
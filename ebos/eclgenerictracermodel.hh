@@ -68,6 +68,12 @@ public:
      */
     Scalar tracerConcentration(int tracerIdx, int globalDofIdx) const;
 
+    /*!
+     * \brief Return the concentrations of all tracers
+     */
+    const std::vector<TracerVector>& tracerConcentrations() const
+    { return tracerConcentration_; }
+
     /*!
     * \brief Return well tracer rates
     */
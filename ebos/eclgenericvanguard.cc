@@ -268,7 +268,8 @@ void EclGenericVanguard::init()
     readDeck(myRank, fileName_, deck_, eclState_, eclSchedule_, udqState_,
              eclSummaryConfig_, std::move(errorGuard), python,
              std::move(parseContext_), /* initFromRestart = */ false,
-             /* checkDeck = */ enableExperiments_, outputInterval_);
+             /* checkDeck = */ enableExperiments_, outputInterval_, deckCacheFile_,
+             nodeSharedBroadcast_);
 
     if (EclGenericVanguard::externalUDQState_)
         this->udqState_ = std::move(EclGenericVanguard::externalUDQState_);
@@ -28,6 +28,7 @@
 #define EWOMS_ECL_GENERIC_VANGUARD_HH
 
 #include <opm/grid/common/GridEnums.hpp>
+#include <opm/simulators/utils/CellCostPartitioning.hpp>
 
 #include <array>
 #include <memory>
@@ -251,6 +252,24 @@ public:
     bool enableDistributedWells() const
     { return enableDistributedWells_; }
 
+    /*!
+     * \brief Whether the grid is partitioned by the estimated cost of the cells.
+     */
+    bool partitionCellCosts() const
+    { return partitionCellCosts_; }
+
+    /*!
+     * \brief Coefficients of the cost of the cells used for partitioning.
+     */
+    const CellCostCoefficients& cellCostCoefficients() const
+    { return cellCostCoefficients_; }
+
+    /*!
+     * \brief File with the cost statistics of the processes, empty if none.
+     */
+    const std::string& cellCostStatisticsFile() const
+    { return cellCostStatisticsFile_; }
+
     /*!
      * \brief Returns vector with name and whether the has local perforated cells
      *        for all wells.
@@ -288,9 +307,14 @@ protected:
     bool serialPartitioning_;
     double zoltanImbalanceTol_;
     bool enableDistributedWells_;
+    bool partitionCellCosts_;
+    CellCostCoefficients cellCostCoefficients_;
+    std::string cellCostStatisticsFile_;
     std::string ignoredKeywords_;
     bool eclStrictParsing_;
     std::optional<int> outputInterval_;
+    std::string deckCacheFile_;
+    bool nodeSharedBroadcast_;
     bool useMultisegmentWell_;
     bool enableExperiments_;
 
@@ -22,24 +22,45 @@
 #define ECL_MPI_SERIALIZER_HH
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
 #include <optional>
+#include <string>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace Opm {
 
 /*! \brief Class for (de-)serializing and broadcasting data in parallel.
  *!  \details Can be called on any class with a serializeOp member. Such classes
  *!           are referred to as 'complex types' in the documentation.
+ *!
+ *!           Trivially copyable scalars, strings and vectors of trivially
+ *!           copyable elements are copied into the buffer with memcpy; other
+ *!           simple types are delegated to the Mpi::pack routines. Buffer
+ *!           positions are 64 bit, and broadcasts are split into chunks which
+ *!           are sent while the root process is still packing.
 */
 
 class EclMpiSerializer {
 public:
     //! \brief Constructor.
     //! \param comm The global communicator to broadcast using
-    explicit EclMpiSerializer(Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> comm) :
-        m_comm(comm)
+    //! \param chunkSize Maximum number of bytes in each broadcast message
+    explicit EclMpiSerializer(Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> comm,
+                              std::size_t chunkSize = defaultChunkSize) :
+        m_comm(comm),
+        m_chunkSize(std::clamp(chunkSize, std::size_t(1),
+                               std::size_t(std::numeric_limits<int>::max())))
     {}
 
+    //! \brief Default size of broadcast chunks (64 MiB).
+    static constexpr std::size_t defaultChunkSize = std::size_t(64) << 20;
+
     //! \brief (De-)serialization for simple types.
     //! \details The data handled by this depends on the underlying serialization used.
     //!          Currently you can call this for scalars, and stl containers with scalars.
@@ -55,12 +76,7 @@ public:
         } else if constexpr (is_optional<T>::value) {
           optional(data);
         } else {
-          if (m_op == Operation::PACKSIZE)
-              m_packSize += Mpi::packSize(data, m_comm);
-          else if (m_op == Operation::PACK)
-              Mpi::pack(data, m_buffer, m_position, m_comm);
-          else if (m_op == Operation::UNPACK)
-              Mpi::unpack(const_cast<T&>(data), m_buffer, m_position, m_comm);
+          simple(const_cast<T&>(data));
         }
     }
 
@@ -71,6 +87,11 @@ public:
     template<class T, bool complexType = true>
     void vector(std::vector<T>& data)
     {
+        if constexpr (!complexType && is_bulk<T>::value) {
+            simple(data);
+            return;
+        }
+
         auto handle = [&](auto& d)
         {
             for (auto& it : d) {
@@ -85,18 +106,11 @@ public:
             }
         };
 
-        if (m_op == Operation::PACKSIZE) {
-            m_packSize += Mpi::packSize(data.size(), m_comm);
-            handle(data);
-        } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.size(), m_buffer, m_position, m_comm);
-            handle(data);
-        } else if (m_op == Operation::UNPACK) {
-            size_t size;
-            Mpi::unpack(size, m_buffer, m_position, m_comm);
+        std::size_t size = data.size();
+        simple(size);
+        if (m_op == Operation::UNPACK)
             data.resize(size);
-            handle(data);
-        }
+        handle(data);
     }
 
 
@@ -122,16 +136,11 @@ public:
         };
 
         std::variant<T0,T1,T2,T3>& data = const_cast<std::variant<T0,T1,T2,T3>&>(_data);
-        if (m_op == Operation::PACKSIZE) {
-            m_packSize += Mpi::packSize(data.index(), m_comm);
-            std::visit( [&] (auto& arg) { handle(arg); }, data);
-        } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.index(), m_buffer, m_position, m_comm);
+        std::size_t index = data.index();
+        simple(index);
+        if (m_op != Operation::UNPACK) {
             std::visit([&](auto& arg) { handle(arg); }, data);
-        } else if (m_op == Operation::UNPACK) {
-            size_t index;
-            Mpi::unpack(index, m_buffer, m_position, m_comm);
-
+        } else {
             if (index == 0) {
                 data = T0();
                 handle(std::get<0>(data));
@@ -164,32 +173,19 @@ public:
     template<class T0, class T1>
     void variant(const std::variant<T0,T1>& data)
     {
-        auto pack_size = [&](auto& d) {
-                             m_packSize += Mpi::packSize(d, m_comm);
-                         };
-
-        auto pack = [&](auto& d) {
-                          Mpi::pack(d, m_buffer, m_position, m_comm);
-                      };
-
-        if (m_op == Operation::PACKSIZE) {
-            m_packSize += Mpi::packSize(data.index(), m_comm);
-            std::visit( [&] (auto& arg) { pack_size(arg); }, data);
-        } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.index(), m_buffer, m_position, m_comm);
-            std::visit([&](auto& arg) { pack(arg); }, data);
-        } else if (m_op == Operation::UNPACK) {
-            size_t index;
-            std::variant<T0,T1>& mutable_data = const_cast<std::variant<T0,T1>&>(data);
-            Mpi::unpack(index, m_buffer, m_position, m_comm);
-
+        std::variant<T0,T1>& mutable_data = const_cast<std::variant<T0,T1>&>(data);
+        std::size_t index = data.index();
+        simple(index);
+        if (m_op != Operation::UNPACK) {
+            std::visit([&](auto& arg) { simple(arg); }, mutable_data);
+        } else {
             if (index == 0) {
                 T0 t0;
-                Mpi::unpack(t0, m_buffer, m_position, m_comm);
+                simple(t0);
                 mutable_data = t0;
             } else if (index == 1) {
                 T1 t1;
-                Mpi::unpack(t1, m_buffer, m_position, m_comm);
+                simple(t1);
                 mutable_data = t1;
             } else
                 throw std::logic_error("Internal meltdown in std::variant<T0,T1> unpack loaded index=" + std::to_string(index) + " allowed range: [0,1]");
@@ -203,37 +199,26 @@ public:
     template<class T>
     void optional(const std::optional<T>& data)
     {
-        if (m_op == Operation::PACKSIZE) {
-            m_packSize += Mpi::packSize(data.has_value(), m_comm);
-            if (data.has_value()) {
-                if constexpr (has_serializeOp<T>::value) {
-                    const_cast<T&>(*data).serializeOp(*this);
-                } else
-                    m_packSize += Mpi::packSize(*data, m_comm);
-            }
-        } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.has_value(), m_buffer, m_position, m_comm);
-            if (data.has_value()) {
-                if constexpr (has_serializeOp<T>::value) {
-                    const_cast<T&>(*data).serializeOp(*this);
-                } else {
-                    Mpi::pack(*data, m_buffer, m_position, m_comm);
-                }
+        bool has = data.has_value();
+        simple(has);
+        if (!has)
+            return;
+
+        if (m_op == Operation::UNPACK) {
+            T res;
+            if constexpr (has_serializeOp<T>::value) {
+                res.serializeOp(*this);
+            } else {
+                simple(res);
             }
-        } else if (m_op == Operation::UNPACK) {
-            bool has;
-            Mpi::unpack(has, m_buffer, m_position, m_comm);
-            if (has) {
-                T res;
-                if constexpr (has_serializeOp<T>::value) {
-                    res.serializeOp(*this);
-                } else {
-                    Mpi::unpack(res, m_buffer, m_position, m_comm);
-                }
-                const_cast<std::optional<T>&>(data) = res;
+            const_cast<std::optional<T>&>(data) = res;
+        } else {
+            if constexpr (has_serializeOp<T>::value) {
+                const_cast<T&>(*data).serializeOp(*this);
+            } else {
+                simple(const_cast<T&>(*data));
             }
         }
-
     }
 
     //! \brief Handler for maps.
@@ -266,22 +251,15 @@ public:
                   (*this)(d);
         };
 
-        if (m_op == Operation::PACKSIZE) {
-            m_packSize += Mpi::packSize(data.size(), m_comm);
+        std::size_t size = data.size();
+        simple(size);
+        if (m_op != Operation::UNPACK) {
             for (auto& it : data) {
                 keyHandle(it.first);
                 handle(it.second);
             }
-        } else if (m_op == Operation::PACK) {
-            Mpi::pack(data.size(), m_buffer, m_position, m_comm);
-            for (auto& it : data) {
-                keyHandle(it.first);
-                handle(it.second);
-            }
-        } else if (m_op == Operation::UNPACK) {
-            size_t size;
-            Mpi::unpack(size, m_buffer, m_position, m_comm);
-            for (size_t i = 0; i < size; ++i) {
+        } else {
+            for (std::size_t i = 0; i < size; ++i) {
                 Key key;
                 keyHandle(key);
                 Data entry;
@@ -317,7 +295,30 @@ public:
         data.serializeOp(*this);
     }
 
+    //! \brief Call this to de-serialize data from an external buffer.
+    //! \details The buffer must have been filled from a previous pack().
+    //! \tparam T Type of class to de-serialize
+    //! \param data Class to de-serialize
+    //! \param buffer Serialized data
+    template<class T>
+    void unpack(T& data, std::vector<char> buffer)
+    {
+        m_buffer = std::move(buffer);
+        unpack(data);
+    }
+
+    //! \brief Returns the serialized data after a call to pack().
+    //! \details The number of valid bytes is given by position().
+    const char* data() const
+    {
+        return m_buffer.data();
+    }
+
     //! \brief Serialize and broadcast on root process, de-serialize on others.
+    //! \details The buffer is broadcast in chunks of at most m_chunkSize bytes
+    //!          using non-blocking collectives. On the root process a chunk is
+    //!          posted as soon as it has been filled, so packing of the
+    //!          remaining data overlaps with the transfer.
     //! \tparam T Type of class to broadcast
     //! \param data Class to broadcast
     template<class T>
@@ -326,26 +327,150 @@ public:
         if (m_comm.size() == 1)
             return;
 
+#if HAVE_MPI
         if (m_comm.rank() == 0) {
             try {
-                pack(data);
-                m_packSize = m_position;
-                m_comm.broadcast(&m_packSize, 1, 0);
-                m_comm.broadcast(m_buffer.data(), m_position, 0);
+                m_op = Operation::PACKSIZE;
+                m_packSize = 0;
+                data.serializeOp(*this);
             } catch (...) {
                 m_packSize = std::numeric_limits<size_t>::max();
                 m_comm.broadcast(&m_packSize, 1, 0);
                 throw;
             }
+
+            m_comm.broadcast(&m_packSize, 1, 0);
+            m_buffer.resize(m_packSize);
+            m_position = 0;
+            m_chunksPosted = 0;
+            m_requests.clear();
+            m_broadcasting = true;
+            std::exception_ptr error;
+            try {
+                m_op = Operation::PACK;
+                data.serializeOp(*this);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            m_broadcasting = false;
+            // Remaining chunks are sent even on error to match the receivers.
+            postChunks(numChunks());
+            waitChunks();
+            int status = error ? 1 : 0;
+            m_comm.broadcast(&status, 1, 0);
+            if (error) {
+                std::rethrow_exception(error);
+            }
         } else {
             m_comm.broadcast(&m_packSize, 1, 0);
             if (m_packSize == std::numeric_limits<size_t>::max()) {
                 throw std::runtime_error("Error detected in parallel serialization");
             }
             m_buffer.resize(m_packSize);
-            m_comm.broadcast(m_buffer.data(), m_packSize, 0);
+            m_chunksPosted = 0;
+            m_requests.clear();
+            postChunks(numChunks());
+            waitChunks();
+            int status = 0;
+            m_comm.broadcast(&status, 1, 0);
+            if (status != 0) {
+                throw std::runtime_error("Error detected in parallel serialization");
+            }
             unpack(data);
         }
+#else
+        (void) data;
+#endif
+    }
+
+    //! \brief Serialize on root process, de-serialize on others from a buffer
+    //!        shared by the processes of each node.
+    //! \details This is a broadcast optimization. The serialized data is
+    //!          sent once to one process on every node, which keeps it in an
+    //!          MPI-3 shared memory window. The other processes on the node
+    //!          de-serialize directly from that window, so only one message
+    //!          per node crosses the network and no process needs its own
+    //!          receive buffer. The de-serialized objects are not shared;
+    //!          every process holds a full copy of them afterwards.
+    //! \tparam T Type of class to broadcast
+    //! \param data Class to broadcast
+    template<class T>
+    void broadcastNodeShared(T& data)
+    {
+        if (m_comm.size() == 1)
+            return;
+
+#if HAVE_MPI
+        const int rank = m_comm.rank();
+        MPI_Comm nodeComm;
+        MPI_Comm_split_type(m_comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+        int nodeRank;
+        MPI_Comm_rank(nodeComm, &nodeRank);
+        // The global root has the lowest key, so it is rank 0 on its node
+        // and among the node leaders.
+        MPI_Comm leaderComm;
+        MPI_Comm_split(m_comm, nodeRank == 0 ? 0 : MPI_UNDEFINED, rank, &leaderComm);
+
+        std::exception_ptr error;
+        if (rank == 0) {
+            try {
+                pack(data);
+            } catch (...) {
+                error = std::current_exception();
+                m_packSize = std::numeric_limits<size_t>::max();
+            }
+        }
+        m_comm.broadcast(&m_packSize, 1, 0);
+
+        if (m_packSize != std::numeric_limits<size_t>::max()) {
+            MPI_Win window;
+            char* shared = nullptr;
+            MPI_Win_allocate_shared(nodeRank == 0 ? m_packSize : 0, 1, MPI_INFO_NULL,
+                                    nodeComm, &shared, &window);
+            if (nodeRank != 0) {
+                MPI_Aint size;
+                int dispUnit;
+                MPI_Win_shared_query(window, 0, &size, &dispUnit, &shared);
+            }
+
+            if (nodeRank == 0) {
+                if (rank == 0 && m_packSize > 0)
+                    std::memcpy(shared, m_buffer.data(), m_packSize);
+                for (std::size_t offset = 0; offset < m_packSize; offset += m_chunkSize) {
+                    const std::size_t count = std::min(m_chunkSize, m_packSize - offset);
+                    MPI_Bcast(shared + offset, static_cast<int>(count), MPI_BYTE, 0, leaderComm);
+                }
+            }
+            MPI_Barrier(nodeComm);
+
+            if (rank != 0) {
+                try {
+                    m_source = shared;
+                    m_position = 0;
+                    m_op = Operation::UNPACK;
+                    data.serializeOp(*this);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                m_source = nullptr;
+            }
+
+            // Nobody may release the window while others still read from it.
+            MPI_Barrier(nodeComm);
+            MPI_Win_free(&window);
+        }
+
+        if (leaderComm != MPI_COMM_NULL)
+            MPI_Comm_free(&leaderComm);
+        MPI_Comm_free(&nodeComm);
+
+        if (error)
+            std::rethrow_exception(error);
+        if (m_packSize == std::numeric_limits<size_t>::max())
+            throw std::runtime_error("Error detected in parallel serialization");
+#else
+        (void) data;
+#endif
     }
 
     //! \brief Returns current position in buffer.
@@ -368,6 +493,123 @@ protected:
         UNPACK    //!< Performing de-serialization
     };
 
+    //! \brief Predicate for types which are copied into the buffer with memcpy.
+    template<class T>
+    struct is_bulk {
+        constexpr static bool value = std::is_trivially_copyable<T>::value &&
+                                      !std::is_pointer<T>::value;
+    };
+
+    //! \brief Handler for simple types.
+    //! \details Trivially copyable data, strings and vectors of trivially
+    //!          copyable data are copied directly. Anything else is packed
+    //!          with the Mpi::pack routines through a scratch buffer.
+    template<class T>
+    void simple(T& data)
+    {
+        if constexpr (is_bulk<T>::value) {
+            bytes(&data, sizeof(T));
+        } else if constexpr (std::is_same<T,std::string>::value) {
+            std::size_t size = data.size();
+            bytes(&size, sizeof(size));
+            if (m_op == Operation::UNPACK)
+                data.resize(size);
+            bytes(data.data(), size);
+        } else if constexpr (is_vector<T>::value &&
+                             !std::is_same<T,std::vector<bool>>::value &&
+                             is_bulk<typename T::value_type>::value) {
+            std::size_t size = data.size();
+            bytes(&size, sizeof(size));
+            if (m_op == Operation::UNPACK)
+                data.resize(size);
+            bytes(data.data(), size * sizeof(typename T::value_type));
+        } else {
+            fallback(data);
+        }
+    }
+
+    //! \brief Copy raw bytes to or from the buffer.
+    void bytes(void* data, std::size_t size)
+    {
+        if (m_op == Operation::PACKSIZE) {
+            m_packSize += size;
+        } else if (m_op == Operation::PACK) {
+            if (size > 0)
+                std::memcpy(m_buffer.data() + m_position, data, size);
+            m_position += size;
+            if (m_broadcasting)
+                postChunks(m_position / m_chunkSize);
+        } else if (m_op == Operation::UNPACK) {
+            if (size > 0)
+                std::memcpy(data, source() + m_position, size);
+            m_position += size;
+        }
+    }
+
+    //! \brief Start of the serialized data when unpacking.
+    const char* source() const
+    {
+        return m_source ? m_source : m_buffer.data();
+    }
+
+    //! \brief Handler for types supported by the Mpi::pack routines only.
+    //! \details These use int buffer positions, so each item is packed into a
+    //!          scratch buffer which is copied into the main buffer prefixed
+    //!          with its size.
+    template<class T>
+    void fallback(T& data)
+    {
+        if (m_op == Operation::PACKSIZE) {
+            m_packSize += sizeof(std::size_t) + Mpi::packSize(data, m_comm);
+        } else if (m_op == Operation::PACK) {
+            m_scratch.resize(Mpi::packSize(data, m_comm));
+            int position = 0;
+            Mpi::pack(data, m_scratch, position, m_comm);
+            std::size_t size = position;
+            bytes(&size, sizeof(size));
+            bytes(m_scratch.data(), size);
+        } else if (m_op == Operation::UNPACK) {
+            std::size_t size;
+            bytes(&size, sizeof(size));
+            m_scratch.assign(source() + m_position,
+                             source() + m_position + size);
+            int position = 0;
+            Mpi::unpack(data, m_scratch, position, m_comm);
+            m_position += size;
+        }
+    }
+
+    //! \brief Number of chunks the broadcast buffer is split into.
+    std::size_t numChunks() const
+    {
+        return (m_packSize + m_chunkSize - 1) / m_chunkSize;
+    }
+
+    //! \brief Post non-blocking broadcasts for chunks up to (not including) last.
+    void postChunks(std::size_t last)
+    {
+#if HAVE_MPI
+        for (; m_chunksPosted < last; ++m_chunksPosted) {
+            const std::size_t offset = m_chunksPosted * m_chunkSize;
+            const std::size_t count = std::min(m_chunkSize, m_packSize - offset);
+            m_requests.emplace_back();
+            MPI_Ibcast(m_buffer.data() + offset, static_cast<int>(count), MPI_BYTE,
+                       0, m_comm, &m_requests.back());
+        }
+#else
+        (void) last;
+#endif
+    }
+
+    //! \brief Wait for all posted chunk broadcasts to complete.
+    void waitChunks()
+    {
+#if HAVE_MPI
+        MPI_Waitall(m_requests.size(), m_requests.data(), MPI_STATUSES_IGNORE);
+        m_requests.clear();
+#endif
+    }
+
     //! \brief Predicate for detecting pairs.
     template<class T>
     struct is_pair {
@@ -480,8 +722,16 @@ protected:
 
     Operation m_op = Operation::PACKSIZE; //!< Current operation
     size_t m_packSize = 0; //!< Required buffer size after PACKSIZE has been done
-    int m_position = 0; //!< Current position in buffer
+    size_t m_position = 0; //!< Current position in buffer
     std::vector<char> m_buffer; //!< Buffer for serialized data
+    const char* m_source = nullptr; //!< External data to unpack from instead of m_buffer
+    std::vector<char> m_scratch; //!< Scratch buffer for Mpi::pack fallbacks
+    std::size_t m_chunkSize; //!< Maximum size of a broadcast chunk
+    std::size_t m_chunksPosted = 0; //!< Number of chunks posted for broadcast
+    bool m_broadcasting = false; //!< True while packing inside broadcast()
+#if HAVE_MPI
+    std::vector<MPI_Request> m_requests; //!< Outstanding chunk broadcasts
+#endif
 };
 
 }
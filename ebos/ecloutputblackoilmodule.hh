@@ -27,10 +27,14 @@
 #ifndef EWOMS_ECL_OUTPUT_BLACK_OIL_MODULE_HH
 #define EWOMS_ECL_OUTPUT_BLACK_OIL_MODULE_HH
 
+#include <algorithm>
 #include <array>
 #include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <opm/models/blackoil/blackoilproperties.hh>
 
@@ -47,6 +51,7 @@
 #include <opm/output/eclipse/Inplace.hpp>
 
 #include <ebos/eclgenericoutputblackoilmodule.hh>
+#include <ebos/eclsaturatedpvtbatch.hh>
 
 #include <dune/common/fvector.hh>
 
@@ -145,6 +150,8 @@ public:
                 this->wbpData_[global_index] = 0.0;
         }
 
+        compileBlockOutput_();
+
         this->forceDisableFipOutput_ = EWOMS_GET_PARAM(TypeTag, bool, ForceDisableFluidInPlaceOutput);
     }
 
@@ -174,6 +181,17 @@ public:
                              simulator_.problem().vapparsActive(std::max(simulator_.episodeIndex(), 0)),
                              simulator_.problem().materialLawManager()->enableHysteresis(),
                              simulator_.problem().tracerModel().numTracers());
+
+        updateCellOutputIndex_(bufferSize);
+
+        const bool batchSaturatedPvt = !this->gasDissolutionFactor_.empty() ||
+                                       !this->oilVaporizationFactor_.empty();
+        if (batchSaturatedPvt && saturatedPvtBatch_.empty()) {
+            std::vector<unsigned> pvtRegionIdx(bufferSize);
+            for (unsigned elemIdx = 0; elemIdx < bufferSize; ++elemIdx)
+                pvtRegionIdx[elemIdx] = simulator_.problem().pvtRegionIndex(elemIdx);
+            saturatedPvtBatch_.init(pvtRegionIdx);
+        }
     }
 
     /*!
@@ -220,19 +238,15 @@ public:
                 this->temperature_[globalDofIdx] = getValue(fs.temperature(oilPhaseIdx));
                 Valgrind::CheckDefined(this->temperature_[globalDofIdx]);
             }
-            if (!this->gasDissolutionFactor_.empty()) {
-                Scalar SoMax = elemCtx.problem().maxOilSaturation(globalDofIdx);
-                this->gasDissolutionFactor_[globalDofIdx] =
-                    FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(fs, oilPhaseIdx, pvtRegionIdx, SoMax);
-                Valgrind::CheckDefined(this->gasDissolutionFactor_[globalDofIdx]);
-
-            }
-            if (!this->oilVaporizationFactor_.empty()) {
-                Scalar SoMax = elemCtx.problem().maxOilSaturation(globalDofIdx);
-                this->oilVaporizationFactor_[globalDofIdx] =
-                    FluidSystem::template saturatedDissolutionFactor<FluidState, Scalar>(fs, gasPhaseIdx, pvtRegionIdx, SoMax);
-                Valgrind::CheckDefined(this->oilVaporizationFactor_[globalDofIdx]);
-
+            // RSSAT and RVSAT are evaluated for all cells at once by
+            // processSaturatedPvt(), only gather their inputs here
+            if (!this->gasDissolutionFactor_.empty() || !this->oilVaporizationFactor_.empty()) {
+                saturatedPvtBatch_.setCell(globalDofIdx,
+                                           getValue(fs.temperature(oilPhaseIdx)),
+                                           getValue(fs.pressure(oilPhaseIdx)),
+                                           getValue(fs.pressure(gasPhaseIdx)),
+                                           getValue(fs.saturation(oilPhaseIdx)),
+                                           problem.maxOilSaturation(globalDofIdx));
             }
             if (!this->gasFormationVolumeFactor_.empty()) {
                 this->gasFormationVolumeFactor_[globalDofIdx] =
@@ -350,6 +364,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical (EclOutputFailedCells)
+#endif
                     this->failedCellsPb_.push_back(cartesianIdx);
                 }
             }
@@ -359,6 +376,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical (EclOutputFailedCells)
+#endif
                     this->failedCellsPd_.push_back(cartesianIdx);
                 }
             }
@@ -456,67 +476,66 @@ public:
             // Add fluid in Place values
             updateFluidInPlace_(elemCtx, dofIdx);
 
-            // Adding block data
-            const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
-            for (auto& val: this->blockData_) {
-                const auto& key = val.first;
-                int cartesianIdxBlock = key.second - 1;
-                if (cartesianIdx == cartesianIdxBlock) {
-                    if ((key.first == "BWSAT") || (key.first == "BSWAT"))
-                        val.second = getValue(fs.saturation(waterPhaseIdx));
-                    else if ((key.first == "BGSAT") || (key.first == "BSGAS"))
-                        val.second = getValue(fs.saturation(gasPhaseIdx));
-                    else if ((key.first == "BOSAT") || (key.first == "BSOIL"))
-                        val.second = getValue(fs.saturation(oilPhaseIdx));
-                    else if ((key.first == "BPR") || (key.first == "BPRESSUR"))
-                        val.second = getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BWKR" || key.first == "BKRW")
-                        val.second = getValue(intQuants.relativePermeability(waterPhaseIdx));
-                    else if (key.first == "BGKR" || key.first == "BKRG")
-                        val.second = getValue(intQuants.relativePermeability(gasPhaseIdx));
-                    else if (key.first == "BOKR" || key.first == "BKRO")
-                        val.second = getValue(intQuants.relativePermeability(oilPhaseIdx));
-                    else if (key.first == "BKROG") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krog = MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krog);
-                    }
-                    else if (key.first == "BKROW") {
-                        const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
-                        const auto krow = MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs);
-                        val.second = getValue(krow);
-                    }
-                    else if (key.first == "BWPC")
-                        val.second = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPC")
-                        val.second = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BVWAT" || key.first == "BWVIS")
-                        val.second = getValue(fs.viscosity(waterPhaseIdx));
-                    else if (key.first == "BVGAS" || key.first == "BGVIS")
-                        val.second = getValue(fs.viscosity(gasPhaseIdx));
-                    else if (key.first == "BVOIL" || key.first == "BOVIS")
-                        val.second = getValue(fs.viscosity(oilPhaseIdx));
-                    else {
-                        std::string logstring = "Keyword '";
-                        logstring.append(key.first);
-                        logstring.append("' is unhandled for output to file.");
-                        OpmLog::warning("Unhandled output keyword", logstring);
-                    }
-                }
-            }
+            // Adding block, well RFT and WBP data
+            const bool hasCellOutput = globalDofIdx + 1 < cellOutputOffsets_.size();
+            for (unsigned entryIdx = hasCellOutput ? cellOutputOffsets_[globalDofIdx] : 0;
+                 hasCellOutput && entryIdx < cellOutputOffsets_[globalDofIdx + 1]; ++entryIdx) {
+                const auto& entry = cellOutputEntries_[entryIdx];
+                double* slot = outputSlot_(entry);
+                if (!slot)
+                    continue;
 
-            // Adding Well RFT data
-            if (this->oilConnectionPressures_.count(cartesianIdx) > 0) {
-                this->oilConnectionPressures_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
-            }
-            if (this->waterConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->waterConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(waterPhaseIdx));
-            }
-            if (this->gasConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->gasConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(gasPhaseIdx));
+                switch (entry.quantity) {
+                case CellQuantity::WaterSaturation:
+                    *slot = getValue(fs.saturation(waterPhaseIdx));
+                    break;
+                case CellQuantity::GasSaturation:
+                    *slot = getValue(fs.saturation(gasPhaseIdx));
+                    break;
+                case CellQuantity::OilSaturation:
+                    *slot = getValue(fs.saturation(oilPhaseIdx));
+                    break;
+                case CellQuantity::Pressure:
+                    *slot = getValue(fs.pressure(oilPhaseIdx));
+                    break;
+                case CellQuantity::WaterRelPerm:
+                    *slot = getValue(intQuants.relativePermeability(waterPhaseIdx));
+                    break;
+                case CellQuantity::GasRelPerm:
+                    *slot = getValue(intQuants.relativePermeability(gasPhaseIdx));
+                    break;
+                case CellQuantity::OilRelPerm:
+                    *slot = getValue(intQuants.relativePermeability(oilPhaseIdx));
+                    break;
+                case CellQuantity::OilGasRelPerm: {
+                    const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
+                    const auto krog = MaterialLaw::template relpermOilInOilGasSystem<Evaluation>(materialParams, fs);
+                    *slot = getValue(krog);
+                    break;
+                }
+                case CellQuantity::OilWaterRelPerm: {
+                    const auto& materialParams = problem.materialLawParams(elemCtx, dofIdx, /* timeIdx = */ 0);
+                    const auto krow = MaterialLaw::template relpermOilInOilWaterSystem<Evaluation>(materialParams, fs);
+                    *slot = getValue(krow);
+                    break;
+                }
+                case CellQuantity::WaterCapPressure:
+                    *slot = getValue(fs.pressure(oilPhaseIdx)) - getValue(fs.pressure(waterPhaseIdx));
+                    break;
+                case CellQuantity::GasCapPressure:
+                    *slot = getValue(fs.pressure(gasPhaseIdx)) - getValue(fs.pressure(oilPhaseIdx));
+                    break;
+                case CellQuantity::WaterViscosity:
+                    *slot = getValue(fs.viscosity(waterPhaseIdx));
+                    break;
+                case CellQuantity::GasViscosity:
+                    *slot = getValue(fs.viscosity(gasPhaseIdx));
+                    break;
+                case CellQuantity::OilViscosity:
+                    *slot = getValue(fs.viscosity(oilPhaseIdx));
+                    break;
+                }
             }
-            if (this->wbpData_.count(cartesianIdx) > 0)
-                this->wbpData_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
 
             // tracers
             const auto& tracerModel = simulator_.problem().tracerModel();
@@ -531,6 +550,24 @@ public:
         }
     }
 
+    /*!
+     * \brief Evaluate the saturated PVT properties of all cells.
+     *
+     * This must be called after processElement() has been called for all
+     * elements.
+     */
+    void processSaturatedPvt()
+    {
+        if (!std::is_same<Discretization, EcfvDiscretization<TypeTag> >::value)
+            return;
+
+        if (!this->gasDissolutionFactor_.empty())
+            saturatedPvtBatch_.saturatedGasDissolutionFactor(this->gasDissolutionFactor_);
+
+        if (!this->oilVaporizationFactor_.empty())
+            saturatedPvtBatch_.saturatedOilVaporizationFactor(this->oilVaporizationFactor_);
+    }
+
     template <class FluidState>
     void assignToFluidState(FluidState& fs, unsigned elemIdx) const
     {
@@ -709,7 +746,201 @@ private:
         }
     }
 
+    /*!
+     * \brief Quantities which are extracted for individual cells for the
+     *        block summary vectors, well RFT data and WBP.
+     */
+    enum class CellQuantity {
+        WaterSaturation,
+        GasSaturation,
+        OilSaturation,
+        Pressure,
+        WaterRelPerm,
+        GasRelPerm,
+        OilRelPerm,
+        OilGasRelPerm,
+        OilWaterRelPerm,
+        WaterCapPressure,
+        GasCapPressure,
+        WaterViscosity,
+        GasViscosity,
+        OilViscosity
+    };
+
+    //! \brief The container which holds the output slot of an entry.
+    enum class OutputTarget {
+        Block,
+        Wbp,
+        OilConnectionPressure,
+        WaterConnectionSaturation,
+        GasConnectionSaturation
+    };
+
+    //! \brief A quantity of a cell to write to an output slot.
+    //! \details The slot is given by its key rather than its address, as
+    //!          the RFT connection data is cleared after every output.
+    struct CellOutputEntry {
+        unsigned cellIdx;
+        CellQuantity quantity;
+        OutputTarget target;
+        std::pair<std::string, int> blockKey; //!< Key of block data
+        std::size_t cartesianIdx; //!< Key of WBP and connection data
+    };
+
+    //! \brief Returns the output slot of an entry, or nullptr if it no longer exists.
+    double* outputSlot_(const CellOutputEntry& entry)
+    {
+        auto find = [](auto& data, const auto& key) -> double*
+        {
+            const auto it = data.find(key);
+            return it == data.end() ? nullptr : &it->second;
+        };
+
+        switch (entry.target) {
+        case OutputTarget::Block:
+            return find(this->blockData_, entry.blockKey);
+        case OutputTarget::Wbp:
+            return find(this->wbpData_, entry.cartesianIdx);
+        case OutputTarget::OilConnectionPressure:
+            return find(this->oilConnectionPressures_, entry.cartesianIdx);
+        case OutputTarget::WaterConnectionSaturation:
+            return find(this->waterConnectionSaturations_, entry.cartesianIdx);
+        case OutputTarget::GasConnectionSaturation:
+            return find(this->gasConnectionSaturations_, entry.cartesianIdx);
+        }
+        return nullptr;
+    }
+
+    static std::optional<CellQuantity> blockQuantity_(const std::string& keyword)
+    {
+        static const std::unordered_map<std::string, CellQuantity> quantities = {
+            {"BWSAT", CellQuantity::WaterSaturation}, {"BSWAT", CellQuantity::WaterSaturation},
+            {"BGSAT", CellQuantity::GasSaturation}, {"BSGAS", CellQuantity::GasSaturation},
+            {"BOSAT", CellQuantity::OilSaturation}, {"BSOIL", CellQuantity::OilSaturation},
+            {"BPR", CellQuantity::Pressure}, {"BPRESSUR", CellQuantity::Pressure},
+            {"BWKR", CellQuantity::WaterRelPerm}, {"BKRW", CellQuantity::WaterRelPerm},
+            {"BGKR", CellQuantity::GasRelPerm}, {"BKRG", CellQuantity::GasRelPerm},
+            {"BOKR", CellQuantity::OilRelPerm}, {"BKRO", CellQuantity::OilRelPerm},
+            {"BKROG", CellQuantity::OilGasRelPerm},
+            {"BKROW", CellQuantity::OilWaterRelPerm},
+            {"BWPC", CellQuantity::WaterCapPressure},
+            {"BGPC", CellQuantity::GasCapPressure},
+            {"BVWAT", CellQuantity::WaterViscosity}, {"BWVIS", CellQuantity::WaterViscosity},
+            {"BVGAS", CellQuantity::GasViscosity}, {"BGVIS", CellQuantity::GasViscosity},
+            {"BVOIL", CellQuantity::OilViscosity}, {"BOVIS", CellQuantity::OilViscosity},
+        };
+
+        const auto it = quantities.find(keyword);
+        if (it == quantities.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    //! \brief Returns the local index of a cell given its Cartesian index, or -1.
+    int localCellIndex_(std::size_t cartesianIdx) const
+    {
+        const auto it = std::lower_bound(cartesianToLocal_.begin(), cartesianToLocal_.end(),
+                                         std::make_pair(static_cast<int>(cartesianIdx), 0u));
+        if (it == cartesianToLocal_.end() || it->first != static_cast<int>(cartesianIdx))
+            return -1;
+        return it->second;
+    }
+
+    /*!
+     * \brief Translates the requested block and WBP data into a list of
+     *        (cell, quantity, output slot) entries.
+     *
+     * The set of requested vectors does not change during the run, so
+     * this is only done once.
+     */
+    void compileBlockOutput_()
+    {
+        const auto& globalCell = simulator_.vanguard().grid().globalCell();
+        cartesianToLocal_.clear();
+        cartesianToLocal_.reserve(globalCell.size());
+        for (unsigned cellIdx = 0; cellIdx < globalCell.size(); ++cellIdx)
+            cartesianToLocal_.emplace_back(globalCell[cellIdx], cellIdx);
+        std::sort(cartesianToLocal_.begin(), cartesianToLocal_.end());
+
+        for (const auto& [key, value] : this->blockData_) {
+            const auto quantity = blockQuantity_(key.first);
+            if (!quantity) {
+                std::string logstring = "Keyword '";
+                logstring.append(key.first);
+                logstring.append("' is unhandled for output to file.");
+                OpmLog::warning("Unhandled output keyword", logstring);
+                continue;
+            }
+
+            const int cellIdx = localCellIndex_(key.second - 1);
+            if (cellIdx >= 0)
+                blockOutputEntries_.push_back({static_cast<unsigned>(cellIdx), *quantity,
+                                               OutputTarget::Block, key, 0});
+        }
+
+        for (const auto& [cartesianIdx, value] : this->wbpData_) {
+            const int cellIdx = localCellIndex_(cartesianIdx);
+            if (cellIdx >= 0)
+                blockOutputEntries_.push_back({static_cast<unsigned>(cellIdx), CellQuantity::Pressure,
+                                               OutputTarget::Wbp, {}, cartesianIdx});
+        }
+    }
+
+    /*!
+     * \brief Sets up the per-cell output entries for the current output step.
+     *
+     * The RFT connection data is reallocated for every report step, so the
+     * precompiled block entries are merged with the current RFT entries here.
+     */
+    void updateCellOutputIndex_(unsigned bufferSize)
+    {
+        static_assert(std::is_same_v<Scalar, double>,
+                      "Output slots of connection data are addressed as double");
+
+        std::vector<CellOutputEntry> entries = blockOutputEntries_;
+        auto addConnectionEntries = [this, &entries](const auto& connectionData,
+                                                     CellQuantity quantity, OutputTarget target)
+        {
+            for (const auto& [cartesianIdx, value] : connectionData) {
+                const int cellIdx = localCellIndex_(cartesianIdx);
+                if (cellIdx >= 0)
+                    entries.push_back({static_cast<unsigned>(cellIdx), quantity, target, {}, cartesianIdx});
+            }
+        };
+        addConnectionEntries(this->oilConnectionPressures_, CellQuantity::Pressure,
+                             OutputTarget::OilConnectionPressure);
+        addConnectionEntries(this->waterConnectionSaturations_, CellQuantity::WaterSaturation,
+                             OutputTarget::WaterConnectionSaturation);
+        addConnectionEntries(this->gasConnectionSaturations_, CellQuantity::GasSaturation,
+                             OutputTarget::GasConnectionSaturation);
+
+        // bucket the entries by cell
+        cellOutputOffsets_.assign(bufferSize + 1, 0);
+        for (const auto& entry : entries) {
+            if (entry.cellIdx < bufferSize)
+                ++cellOutputOffsets_[entry.cellIdx + 1];
+        }
+        std::partial_sum(cellOutputOffsets_.begin(), cellOutputOffsets_.end(),
+                         cellOutputOffsets_.begin());
+        cellOutputEntries_.resize(cellOutputOffsets_.back());
+        std::vector<unsigned> next(cellOutputOffsets_.begin(), cellOutputOffsets_.end() - 1);
+        for (const auto& entry : entries) {
+            if (entry.cellIdx < bufferSize)
+                cellOutputEntries_[next[entry.cellIdx]++] = entry;
+        }
+    }
+
     const Simulator& simulator_;
+
+    //! \brief Sorted pairs of Cartesian and local cell index.
+    std::vector<std::pair<int, unsigned>> cartesianToLocal_;
+    //! \brief Precompiled block and WBP output entries.
+    std::vector<CellOutputEntry> blockOutputEntries_;
+    //! \brief CSR map from local cells to the output entries of the cell.
+    std::vector<unsigned> cellOutputOffsets_;
+    std::vector<CellOutputEntry> cellOutputEntries_;
+    //! \brief Inputs of the RSSAT and RVSAT output, grouped by PVT region.
+    EclSaturatedPvtBatch<FluidSystem, Scalar> saturatedPvtBatch_;
 };
 
 } // namespace Opm
@@ -0,0 +1,124 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \copydoc Opm::EclPffGridVector
+ */
+#ifndef EWOMS_ECL_PFF_GRID_VECTOR_HH
+#define EWOMS_ECL_PFF_GRID_VECTOR_HH
+
+#include <opm/models/utils/prefetch.hh>
+
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <cassert>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \ingroup EclBlackOilSimulator
+ *
+ * \brief A random-access container which stores data attached to the
+ *        degrees of freedom of the stencils of a grid's elements in a
+ *        prefetch friendly manner.
+ *
+ * This is the PffGridVector of opm-models, with write access to single
+ * entries. It allows to update the data of a few elements without
+ * re-evaluating the data of the whole grid.
+ */
+template <class GridView, class Stencil, class Data, class DofMapper>
+class EclPffGridVector
+{
+    using Element = typename GridView::template Codim<0>::Entity;
+    using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
+
+public:
+    EclPffGridVector(const GridView& gridView, const DofMapper& dofMapper)
+        : gridView_(gridView)
+        , elementMapper_(gridView_, Dune::mcmgElementLayout())
+        , dofMapper_(dofMapper)
+    { }
+
+    /*!
+     * \brief Set the data of all degrees of freedom of all stencils.
+     *
+     * The function is called as distFunction(data, stencil, localDofIdx).
+     */
+    template <class DistFn>
+    void update(const DistFn& distFunction)
+    {
+        const unsigned numElements = gridView_.size(/*codim=*/0);
+        Stencil stencil(gridView_, dofMapper_);
+
+        // determine where the data of each element starts
+        elemStartIdx_.assign(numElements + 1, 0);
+        const auto& elemEndIt = gridView_.template end</*codim=*/0>();
+        for (auto elemIt = gridView_.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+            stencil.update(*elemIt);
+            elemStartIdx_[elementMapper_.index(*elemIt) + 1] = stencil.numDof();
+        }
+        for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx)
+            elemStartIdx_[elemIdx + 1] += elemStartIdx_[elemIdx];
+
+        data_.resize(elemStartIdx_[numElements]);
+        for (auto elemIt = gridView_.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+            stencil.update(*elemIt);
+            const unsigned startIdx = elemStartIdx_[elementMapper_.index(*elemIt)];
+            for (unsigned localDofIdx = 0; localDofIdx < stencil.numDof(); ++localDofIdx)
+                distFunction(data_[startIdx + localDofIdx], stencil, localDofIdx);
+        }
+    }
+
+    void prefetch(const Element& elem) const
+    {
+        const unsigned elemIdx = elementMapper_.index(elem);
+        const unsigned startIdx = elemStartIdx_[elemIdx];
+        Opm::prefetch(data_[startIdx], elemStartIdx_[elemIdx + 1] - startIdx);
+    }
+
+    const Data& get(const Element& elem, unsigned localDofIdx) const
+    { return data_[index_(elem, localDofIdx)]; }
+
+    Data& get(const Element& elem, unsigned localDofIdx)
+    { return data_[index_(elem, localDofIdx)]; }
+
+private:
+    unsigned index_(const Element& elem, unsigned localDofIdx) const
+    {
+        const unsigned elemIdx = elementMapper_.index(elem);
+        assert(elemStartIdx_[elemIdx] + localDofIdx < elemStartIdx_[elemIdx + 1]);
+        return elemStartIdx_[elemIdx] + localDofIdx;
+    }
+
+    GridView gridView_;
+    ElementMapper elementMapper_;
+    const DofMapper& dofMapper_;
+    std::vector<Data> data_;
+    std::vector<unsigned> elemStartIdx_;
+};
+
+} // namespace Opm
+
+#endif
@@ -65,10 +65,10 @@
 #include "ecltracermodel.hh"
 #include "vtkecltracermodule.hh"
 #include "eclgenericproblem.hh"
+#include "eclpffgridvector.hh"
 
 #include <opm/core/props/satfunc/RelpermDiagnostics.hpp>
 
-#include <opm/models/utils/pffgridvector.hh>
 #include <opm/models/blackoil/blackoilmodel.hh>
 #include <opm/models/discretization/ecfv/ecfvdiscretization.hh>
 
@@ -943,6 +943,102 @@ public:
     void prefetch(const Element& elem) const
     { pffDofData_.prefetch(elem); }
 
+    /*!
+     * \brief In-memory copy of the history dependent state of the problem.
+     *
+     * This covers the per-cell quantities which depend on the history of the
+     * solution rather than only on the current primary variables: the maximum
+     * oil and water saturations, the minimum oil pressure, the DRSDT/DRVDT
+     * trackers, the polymer adsorption, the hysteresis parameters of the
+     * material laws and the tracer concentrations. The well and aquifer models
+     * hold their own state.
+     */
+    struct Checkpoint
+    {
+        std::vector<Scalar> maxOilSaturation;
+        std::vector<Scalar> maxPolymerAdsorption;
+        std::vector<Scalar> maxWaterSaturation;
+        std::vector<Scalar> minOilPressure;
+        std::vector<Scalar> lastRv;
+        std::vector<Scalar> maxDRv;
+        std::vector<Scalar> convectiveDrs;
+        std::vector<Scalar> lastRs;
+        std::vector<Scalar> maxDRs;
+
+        std::vector<Scalar> pcSwMdcOw;
+        std::vector<Scalar> krnSwMdcOw;
+        std::vector<Scalar> pcSwMdcGo;
+        std::vector<Scalar> krnSwMdcGo;
+
+        std::vector<typename TracerModel::TracerVector> tracerConcentrations;
+    };
+
+    /*!
+     * \brief Returns a copy of the history dependent state of the problem.
+     */
+    Checkpoint checkpoint() const
+    {
+        Checkpoint cp;
+        cp.maxOilSaturation = this->maxOilSaturation_;
+        cp.maxPolymerAdsorption = this->maxPolymerAdsorption_;
+        cp.maxWaterSaturation = this->maxWaterSaturation_;
+        cp.minOilPressure = this->minOilPressure_;
+        cp.lastRv = this->lastRv_;
+        cp.maxDRv = this->maxDRv_;
+        cp.convectiveDrs = this->convectiveDrs_;
+        cp.lastRs = this->lastRs_;
+        cp.maxDRs = this->maxDRs_;
+
+        if (materialLawManager_->enableHysteresis()) {
+            const std::size_t numElements = this->model().numGridDof();
+            cp.pcSwMdcOw.resize(numElements);
+            cp.krnSwMdcOw.resize(numElements);
+            cp.pcSwMdcGo.resize(numElements);
+            cp.krnSwMdcGo.resize(numElements);
+            for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+                materialLawManager_->oilWaterHysteresisParams(cp.pcSwMdcOw[elemIdx],
+                                                              cp.krnSwMdcOw[elemIdx],
+                                                              elemIdx);
+                materialLawManager_->gasOilHysteresisParams(cp.pcSwMdcGo[elemIdx],
+                                                            cp.krnSwMdcGo[elemIdx],
+                                                            elemIdx);
+            }
+        }
+
+        cp.tracerConcentrations = tracerModel_.tracerConcentrations();
+        return cp;
+    }
+
+    /*!
+     * \brief Restores the history dependent state of the problem from a
+     *        checkpoint().
+     *
+     * The cached intensive quantities are not updated by this method.
+     */
+    void restore(const Checkpoint& cp)
+    {
+        this->maxOilSaturation_ = cp.maxOilSaturation;
+        this->maxPolymerAdsorption_ = cp.maxPolymerAdsorption;
+        this->maxWaterSaturation_ = cp.maxWaterSaturation;
+        this->minOilPressure_ = cp.minOilPressure;
+        this->lastRv_ = cp.lastRv;
+        this->maxDRv_ = cp.maxDRv;
+        this->convectiveDrs_ = cp.convectiveDrs;
+        this->lastRs_ = cp.lastRs;
+        this->maxDRs_ = cp.maxDRs;
+
+        for (std::size_t elemIdx = 0; elemIdx < cp.pcSwMdcOw.size(); ++elemIdx) {
+            materialLawManager_->setOilWaterHysteresisParams(cp.pcSwMdcOw[elemIdx],
+                                                             cp.krnSwMdcOw[elemIdx],
+                                                             elemIdx);
+            materialLawManager_->setGasOilHysteresisParams(cp.pcSwMdcGo[elemIdx],
+                                                           cp.krnSwMdcGo[elemIdx],
+                                                           elemIdx);
+        }
+
+        tracerModel_.setTracerConcentrations(cp.tracerConcentrations);
+    }
+
     /*!
      * \brief This method restores the complete state of the problem and its sub-objects
      *        from disk.
@@ -1010,11 +1106,16 @@ public:
             const auto& miniDeck = schedule[episodeIdx].geo_keywords();
             eclState.apply_geo_keywords( miniDeck );
 
-            // re-compute all quantities which may possibly be affected.
-            transmissibilities_.update(true);
+            // re-compute all quantities which may possibly be affected. where
+            // possible, only the transmissibilities whose multipliers changed
+            // are updated.
+            const auto changedConnections = transmissibilities_.updateMultipliers(true);
             this->referencePorosity_[1] = this->referencePorosity_[0];
             updateReferencePorosity_();
-            updatePffDofData_();
+            if (changedConnections)
+                updatePffDofData_(*changedConnections);
+            else
+                updatePffDofData_();
         }
 
         bool tuningEvent = this->beginEpisode_(enableExperiments, this->episodeIndex());
@@ -1054,11 +1155,17 @@ public:
         // update maximum water saturation and minimum pressure
         // used when ROCKCOMP is activated
         const bool invalidateFromMaxWaterSat = updateMaxWaterSaturation_();
-        const bool invalidateFromMinPressure = updateMinPressure_();
+
+        // a solution which has been rolled back to the start of the time
+        // step has already been seen by the other history dependent
+        // quantities, and the intensive quantities are up to date with them
+        const bool updateHistory = !timeStepRolledBack_;
+        timeStepRolledBack_ = false;
+        const bool invalidateFromMinPressure = updateHistory && updateMinPressure_();
 
         // update hysteresis and max oil saturation used in vappars
-        const bool invalidateFromHyst = updateHysteresis_();
-        const bool invalidateFromMaxOilSat = updateMaxOilSaturation_();
+        const bool invalidateFromHyst = updateHistory && updateHysteresis_();
+        const bool invalidateFromMaxOilSat = updateHistory && updateMaxOilSaturation_();
 
         // the derivatives may have change
         bool invalidateIntensiveQuantities = invalidateFromMaxWaterSat || invalidateFromMinPressure || invalidateFromHyst || invalidateFromMaxOilSat;
@@ -1066,7 +1173,8 @@ public:
             this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
 
         if constexpr (getPropValue<TypeTag, Properties::EnablePolymer>())
-            updateMaxPolymerAdsorption_();
+            if (updateHistory)
+                updateMaxPolymerAdsorption_();
 
         wellModel_.beginTimeStep();
         if (enableAquifers_)
@@ -1075,6 +1183,17 @@ public:
 
     }
 
+    /*!
+     * \brief Tell the problem that the solution and the cached intensive
+     *        quantities have been reset to the start of the current time step.
+     *
+     * The next call of beginTimeStep() then does not update the history
+     * dependent quantities again: they have already been updated for this
+     * solution when the time step was started the first time.
+     */
+    void timeStepRolledBack()
+    { timeStepRolledBack_ = true; }
+
     /*!
      * \brief Called by the simulator before each Newton-Raphson iteration.
      */
@@ -1262,9 +1381,14 @@ public:
             ts = os.str();
         }
 
-        for (const auto& pyaction : actions.pending_python()) {
+        const auto& pyactions = actions.pending_python();
+        for (const auto& pyaction : pyactions) {
             pyaction->run(ecl_state, schedule, reportStep, summaryState);
         }
+        // A Python action may change any well of the Schedule, this only
+        // refreshes what the well model derives from the group tree.
+        if (!pyactions.empty())
+            this->wellModel_.updateEclWells(reportStep, {});
 
         bool commit_wellstate = false;
         auto simTime = asTimeT(now);
@@ -1403,6 +1527,22 @@ public:
     const typename Vanguard::TransmissibilityType& eclTransmissibilities() const
     { return transmissibilities_; }
 
+    /*!
+     * \brief Scale the intrinsic permeability of each element and recompute the
+     *        transmissibilities.
+     *
+     * The connection factors of the wells are not changed.
+     *
+     * \param multipliers One multiplier per element, relative to the
+     *                    permeability of the deck.
+     */
+    void setPermeabilityMultipliers(std::vector<Scalar> multipliers)
+    {
+        transmissibilities_.setPermeabilityMultipliers(std::move(multipliers));
+        transmissibilities_.update(/*global=*/true);
+        updatePffDofData_();
+    }
+
     /*!
      * \copydoc BlackOilBaseProblem::thresholdPressure
      */
@@ -2683,6 +2823,38 @@ private:
         pffDofData_.update(distFn);
     }
 
+    // update the transmissibilities of the prefetch friendly data object for
+    // the elements of the given connections only
+    void updatePffDofData_(const std::vector<std::pair<unsigned, unsigned>>& connections)
+    {
+        if (connections.empty())
+            return;
+
+        const auto& elementMapper = this->model().elementMapper();
+        std::vector<bool> isAffected(this->model().numGridDof(), false);
+        for (const auto& [elemIdx1, elemIdx2] : connections) {
+            isAffected[elemIdx1] = true;
+            isAffected[elemIdx2] = true;
+        }
+
+        Stencil stencil(this->gridView(), this->model().dofMapper());
+        auto elemIt = this->gridView().template begin</*codim=*/0>();
+        const auto& elemEndIt = this->gridView().template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const Element& elem = *elemIt;
+            unsigned globalCenterElemIdx = elementMapper.index(elem);
+            if (!isAffected[globalCenterElemIdx])
+                continue;
+
+            stencil.update(elem);
+            for (unsigned localDofIdx = 1; localDofIdx < stencil.numDof(); ++localDofIdx) {
+                unsigned globalElemIdx = elementMapper.index(stencil.entity(localDofIdx));
+                auto& dofData = pffDofData_.get(elem, localDofIdx);
+                dofData.transmissibility = transmissibilities_.transmissibility(globalCenterElemIdx, globalElemIdx);
+            }
+        }
+    }
+
     void readBoundaryConditions_()
     {
         nonTrivialBoundaryConditions_ = false;
@@ -2886,9 +3058,11 @@ private:
     bool enableEclOutput_;
     std::unique_ptr<EclWriterType> eclWriter_;
 
-    PffGridVector<GridView, Stencil, PffDofData_, DofMapper> pffDofData_;
+    EclPffGridVector<GridView, Stencil, PffDofData_, DofMapper> pffDofData_;
     TracerModel tracerModel_;
 
+    bool timeStepRolledBack_ = false;
+
     std::vector<bool> freebcX_;
     std::vector<bool> freebcXMinus_;
     std::vector<bool> freebcY_;
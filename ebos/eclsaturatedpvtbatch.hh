@@ -0,0 +1,187 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \copydoc Opm::EclSaturatedPvtBatch
+ */
+#ifndef EWOMS_ECL_SATURATED_PVT_BATCH_HH
+#define EWOMS_ECL_SATURATED_PVT_BATCH_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \ingroup EclBlackOilSimulator
+ *
+ * \brief Evaluates the saturated PVT properties of many cells at once.
+ *
+ * The inputs of the cells are gathered during the element sweep and stored
+ * grouped by PVT region. The properties are then evaluated region by region
+ * by calling the PVT objects of the fluid system directly, so consecutive
+ * evaluations use the same tables and the dispatch of the fluid system on
+ * the phase is not done for every cell.
+ */
+template <class FluidSystem, class Scalar>
+class EclSaturatedPvtBatch
+{
+    //! \brief Cells of one PVT region which are evaluated together.
+    struct Range
+    {
+        unsigned regionIdx;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    //! \brief Maximum number of cells of a range.
+    static constexpr std::size_t maxRangeSize = 4096;
+
+public:
+    bool empty() const
+    { return order_.empty(); }
+
+    /*!
+     * \brief Sets up the batch for cells with the given PVT regions.
+     *
+     * The PVT regions of the cells do not change during a run, so this only
+     * needs to be done once.
+     */
+    void init(const std::vector<unsigned>& pvtRegionIdx)
+    {
+        const std::size_t numCells = pvtRegionIdx.size();
+        order_.resize(numCells);
+        std::iota(order_.begin(), order_.end(), 0u);
+        std::stable_sort(order_.begin(), order_.end(),
+                         [&pvtRegionIdx](unsigned a, unsigned b)
+                         { return pvtRegionIdx[a] < pvtRegionIdx[b]; });
+
+        position_.resize(numCells);
+        for (std::size_t pos = 0; pos < numCells; ++pos)
+            position_[order_[pos]] = pos;
+
+        ranges_.clear();
+        for (std::size_t begin = 0; begin < numCells; ) {
+            const unsigned regionIdx = pvtRegionIdx[order_[begin]];
+            std::size_t end = begin + 1;
+            while (end < numCells && end - begin < maxRangeSize &&
+                   pvtRegionIdx[order_[end]] == regionIdx)
+                ++end;
+            ranges_.push_back({regionIdx, begin, end});
+            begin = end;
+        }
+
+        temperature_.resize(numCells);
+        oilPressure_.resize(numCells);
+        gasPressure_.resize(numCells);
+        oilSaturation_.resize(numCells);
+        maxOilSaturation_.resize(numCells);
+    }
+
+    /*!
+     * \brief Stores the inputs of a cell.
+     *
+     * Every cell writes its own entries only, so this may be called
+     * concurrently for different cells.
+     */
+    void setCell(unsigned cellIdx,
+                 Scalar temperature,
+                 Scalar oilPressure,
+                 Scalar gasPressure,
+                 Scalar oilSaturation,
+                 Scalar maxOilSaturation)
+    {
+        const std::size_t pos = position_[cellIdx];
+        temperature_[pos] = temperature;
+        oilPressure_[pos] = oilPressure;
+        gasPressure_[pos] = gasPressure;
+        oilSaturation_[pos] = oilSaturation;
+        maxOilSaturation_[pos] = maxOilSaturation;
+    }
+
+    /*!
+     * \brief Computes the gas dissolution factor of saturated oil of all cells.
+     */
+    void saturatedGasDissolutionFactor(std::vector<Scalar>& result) const
+    {
+        const auto& oilPvt = FluidSystem::oilPvt();
+        evaluate_(result, [&oilPvt, this](unsigned regionIdx, std::size_t pos)
+        {
+            return oilPvt.saturatedGasDissolutionFactor(regionIdx,
+                                                        temperature_[pos],
+                                                        oilPressure_[pos],
+                                                        oilSaturation_[pos],
+                                                        maxOilSaturation_[pos]);
+        });
+    }
+
+    /*!
+     * \brief Computes the oil vaporization factor of saturated gas of all cells.
+     */
+    void saturatedOilVaporizationFactor(std::vector<Scalar>& result) const
+    {
+        const auto& gasPvt = FluidSystem::gasPvt();
+        evaluate_(result, [&gasPvt, this](unsigned regionIdx, std::size_t pos)
+        {
+            return gasPvt.saturatedOilVaporizationFactor(regionIdx,
+                                                         temperature_[pos],
+                                                         gasPressure_[pos],
+                                                         oilSaturation_[pos],
+                                                         maxOilSaturation_[pos]);
+        });
+    }
+
+private:
+    template <class Eval>
+    void evaluate_(std::vector<Scalar>& result, const Eval& eval) const
+    {
+        const int numRanges = ranges_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int rangeIdx = 0; rangeIdx < numRanges; ++rangeIdx) {
+            const auto& range = ranges_[rangeIdx];
+            for (std::size_t pos = range.begin; pos < range.end; ++pos)
+                result[order_[pos]] = eval(range.regionIdx, pos);
+        }
+    }
+
+    //! \brief Cell indices sorted by PVT region.
+    std::vector<unsigned> order_;
+    //! \brief Position of each cell in order_.
+    std::vector<std::size_t> position_;
+    std::vector<Range> ranges_;
+
+    std::vector<Scalar> temperature_;
+    std::vector<Scalar> oilPressure_;
+    std::vector<Scalar> gasPressure_;
+    std::vector<Scalar> oilSaturation_;
+    std::vector<Scalar> maxOilSaturation_;
+};
+
+} // namespace Opm
+
+#endif
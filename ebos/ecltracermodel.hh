@@ -133,6 +133,19 @@ public:
         advanceTracerFields(gas_);
     }
 
+    /*!
+     * \brief Set the concentrations of all tracers, e.g. when restoring a
+     *        checkpoint of the simulation.
+     */
+    void setTracerConcentrations(const std::vector<TracerVector>& concentrations)
+    {
+        this->tracerConcentration_ = concentrations;
+        for (auto* tr : {&wat_, &oil_, &gas_}) {
+            for (int tIdx = 0; tIdx < tr->numTracer(); ++tIdx)
+                tr->concentration_[tIdx] = concentrations[tr->idx_[tIdx]];
+        }
+    }
+
     /*!
      * \brief This method writes the complete state of all tracer
      *        to the hard disk.
@@ -307,6 +320,8 @@ protected:
                 wtracer[tIdx] = well.getTracerProperties().getConcentration(this->tracerNames_[tr.idx_[tIdx]]);
             }
 
+            const auto wellPtr = simulator_.problem().wellModel().well(well.name());
+            std::vector<Scalar> wtracerRate(tr.numTracer(), 0.0);
             std::array<int, 3> cartesianCoordinate;
             for (auto& connection : well.getConnections()) {
 
@@ -318,12 +333,11 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = this->cartToGlobal_[cartIdx];
-                Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
+                Scalar rate = wellPtr->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
                 if (rate > 0) {
                     for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
                         tr.residual_[tIdx][I][0] -= rate*wtracer[tIdx];
-                        // Store _injector_ tracer rate for reporting
-                        this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) += rate*wtracer[tIdx];
+                        wtracerRate[tIdx] += rate*wtracer[tIdx];
                     }
                 }
                 else if (rate < 0) {
@@ -333,6 +347,11 @@ protected:
                     (*this->tracerMatrix_)[I][I][0][0] -= rate*variable<TracerEvaluation>(1.0, 0).derivative(0);
                 }
             }
+
+            // Store _injector_ tracer rate for reporting
+            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
+                this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) = wtracerRate[tIdx];
+            }
         }
     }
 
@@ -393,6 +412,8 @@ protected:
             if (!well.isProducer()) //Injection rates already reported during assembly
                 continue;
 
+            const auto wellPtr = simulator_.problem().wellModel().well(well.name());
+            std::vector<Scalar> wtracerRate(tr.numTracer(), 0.0);
             Scalar rateWellPos = 0.0;
             Scalar rateWellNeg = 0.0;
             std::array<int, 3> cartesianCoordinate;
@@ -406,11 +427,11 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = this->cartToGlobal_[cartIdx];
-                Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
+                Scalar rate = wellPtr->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
                 if (rate < 0) {
                     rateWellNeg += rate;
                     for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                        this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) += rate*tr.concentration_[tIdx][I];
+                        wtracerRate[tIdx] += rate*tr.concentration_[tIdx][I];
                     }
                 }
                 else {
@@ -428,11 +449,19 @@ protected:
 
             rateWellTotal = official_well_rate_total;
 
+            // the cross flow factor scales the whole rate of the well, including
+            // the injection through cross flowing connections stored during assembly
+            std::vector<double*> wellTracerRate(tr.numTracer());
+            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
+                wellTracerRate[tIdx] = &this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]]));
+                *wellTracerRate[tIdx] += wtracerRate[tIdx];
+            }
+
             if (rateWellTotal > rateWellNeg) { // Cross flow
                 const Scalar bucketPrDay = 10.0/(1000.*3600.*24.); // ... keeps (some) trouble away
                 const Scalar factor = (rateWellTotal < -bucketPrDay) ? rateWellTotal/rateWellNeg : 0.0;
                 for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) *= factor;
+                    *wellTracerRate[tIdx] *= factor;
                 }
             }
         }
@@ -224,6 +224,10 @@ update(bool global)
     if (global && comm.size() > 1) {
         comm.broadcast(&useSmallestMultiplier, 1, 0);
     }
+    useSmallestMultiplier_ = useSmallestMultiplier;
+
+    multiplierFaces_.clear();
+    nncModifiedFaces_.clear();
 
     // compute the transmissibilities for all intersections
     elemIt = gridView_.template begin</*codim=*/ 0>();
@@ -359,49 +363,17 @@ update(bool global)
             else
                 trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
 
-            // apply the full face transmissibility multipliers
-            // for the inside ...
-
-            if (useSmallestMultiplier)
-            {
-                // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
-                // and in this branch PINCH(5) == ALL holds
-                applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
-                                      outsideCartElemIdx, transMult, cartDims,
-                                      /* pinchTop= */ false);
-            }
-            else
-            {
-                applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
-                // ... and outside elements
-                applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
-            }
-
-            // apply the region multipliers (cf. the MULTREGT keyword)
-            FaceDir::DirEnum faceDir;
-            switch (insideFaceIdx) {
-            case 0:
-            case 1:
-                faceDir = FaceDir::XPlus;
-                break;
-
-            case 2:
-            case 3:
-                faceDir = FaceDir::YPlus;
-                break;
-
-            case 4:
-            case 5:
-                faceDir = FaceDir::ZPlus;
-                break;
-
-            default:
-                throw std::logic_error("Could not determine a face direction");
-            }
+            const Scalar unmultipliedTrans = trans;
+            applyFaceMultipliers_(trans, insideFaceIdx, outsideFaceIdx,
+                                  insideCartElemIdx, outsideCartElemIdx,
+                                  transMult, cartDims);
 
-            trans *= transMult.getRegionMultiplier(insideCartElemIdx,
-                                                   outsideCartElemIdx,
-                                                   faceDir);
+            if (recordMultiplierFaces_)
+                multiplierFaces_.push_back({isId(elemIdx, outsideElemIdx),
+                                            elemIdx, outsideElemIdx,
+                                            insideCartElemIdx, outsideCartElemIdx,
+                                            insideFaceIdx, outsideFaceIdx,
+                                            unmultipliedTrans, trans});
 
             trans_[isId(elemIdx, outsideElemIdx)] = trans;
 
@@ -491,6 +463,144 @@ update(bool global)
     removeSmallNonCartesianTransmissibilities_();
 }
 
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+std::optional<std::vector<std::pair<unsigned, unsigned>>>
+EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+updateMultipliers(bool global)
+{
+    const FieldPropsManager* fp =
+        (global) ? &(eclState_.fieldProps()) :
+        &(eclState_.globalFieldProps());
+    const bool isTran = fp->tran_active("TRANX") ||
+                        fp->tran_active("TRANY") ||
+                        fp->tran_active("TRANZ");
+
+    // TRAN{XYZ} operate on the final transmissibilities, hence these
+    // need to be recomputed from scratch.
+    if (isTran || !recordMultiplierFaces_) {
+        recordMultiplierFaces_ = !isTran;
+        update(global);
+        return std::nullopt;
+    }
+
+    const auto& cartDims = cartMapper_.cartesianDimensions();
+    const auto& transMult = eclState_.getTransMult();
+
+    // evaluating the multipliers is independent for each face
+    std::vector<Scalar> newTrans(multiplierFaces_.size());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t faceIdx = 0; faceIdx < multiplierFaces_.size(); ++faceIdx) {
+        const auto& face = multiplierFaces_[faceIdx];
+        Scalar trans = face.unmultipliedTrans;
+        applyFaceMultipliers_(trans, face.insideFaceIdx, face.outsideFaceIdx,
+                              face.insideCartElemIdx, face.outsideCartElemIdx,
+                              transMult, cartDims);
+        newTrans[faceIdx] = trans;
+    }
+
+    // NNC and EDITNNC were applied on top of the old value of a changed face
+    // modified by them. update() is collective, hence all processes have to
+    // agree on doing it before anything is changed.
+    int needsFullUpdate = 0;
+    for (std::size_t faceIdx = 0; faceIdx < multiplierFaces_.size(); ++faceIdx) {
+        const auto& face = multiplierFaces_[faceIdx];
+        if (newTrans[faceIdx] != face.trans && nncModifiedFaces_.count(face.id) > 0) {
+            needsFullUpdate = 1;
+            break;
+        }
+    }
+    if (global && grid_.comm().size() > 1)
+        needsFullUpdate = grid_.comm().max(needsFullUpdate);
+
+    if (needsFullUpdate) {
+        update(global);
+        return std::nullopt;
+    }
+
+    std::vector<std::pair<unsigned, unsigned>> changed;
+    for (std::size_t faceIdx = 0; faceIdx < multiplierFaces_.size(); ++faceIdx) {
+        auto& face = multiplierFaces_[faceIdx];
+        if (newTrans[faceIdx] == face.trans)
+            continue;
+
+        face.trans = newTrans[faceIdx];
+        auto& trans = trans_[face.id];
+        trans = face.trans;
+        removeSmallNonCartesianTransmissibility_(face.id, trans);
+        changed.emplace_back(face.insideElemIdx, face.outsideElemIdx);
+    }
+
+    return changed;
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+applyFaceMultipliers_(Scalar& trans,
+                      int insideFaceIdx,
+                      int outsideFaceIdx,
+                      unsigned insideCartElemIdx,
+                      unsigned outsideCartElemIdx,
+                      const TransMult& transMult,
+                      const std::array<int, dimWorld>& cartDims) const
+{
+    // apply the full face transmissibility multipliers
+    // for the inside ...
+
+    if (useSmallestMultiplier_)
+    {
+        // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
+        // and in this branch PINCH(5) == ALL holds
+        applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
+                              outsideCartElemIdx, transMult, cartDims,
+                              /* pinchTop= */ false);
+    }
+    else
+    {
+        applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
+        // ... and outside elements
+        applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
+    }
+
+    // apply the region multipliers (cf. the MULTREGT keyword)
+    FaceDir::DirEnum faceDir;
+    switch (insideFaceIdx) {
+    case 0:
+    case 1:
+        faceDir = FaceDir::XPlus;
+        break;
+
+    case 2:
+    case 3:
+        faceDir = FaceDir::YPlus;
+        break;
+
+    case 4:
+    case 5:
+        faceDir = FaceDir::ZPlus;
+        break;
+
+    default:
+        throw std::logic_error("Could not determine a face direction");
+    }
+
+    trans *= transMult.getRegionMultiplier(insideCartElemIdx,
+                                           outsideCartElemIdx,
+                                           faceDir);
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+bool EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+isCartesianNeighbor_(unsigned cartElemIdx1, unsigned cartElemIdx2) const
+{
+    const auto& cartDims = cartMapper_.cartesianDimensions();
+    int gc1 = std::min(cartElemIdx1, cartElemIdx2);
+    int gc2 = std::max(cartElemIdx1, cartElemIdx2);
+
+    return gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1];
+}
+
 template<class Grid, class GridView, class ElementMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 extractPermeability_()
@@ -527,6 +637,10 @@ extractPermeability_()
 
         // for now we don't care about non-diagonal entries
 
+        if (!permeabilityMultipliers_.empty()) {
+            for (size_t dofIdx = 0; dofIdx < numElem; ++ dofIdx)
+                permeability_[dofIdx] *= permeabilityMultipliers_[dofIdx];
+        }
     }
     else
         throw std::logic_error("Can't read the intrinsic permeability from the ecl state. "
@@ -554,21 +668,24 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 removeSmallNonCartesianTransmissibilities_()
 {
-    const auto& cartDims = cartMapper_.cartesianDimensions();
-    for (auto&& trans: trans_) {
-        if (trans.second < transmissibilityThreshold_) {
-            const auto& id = trans.first;
-            const auto& elements = isIdReverse(id);
-            int gc1 = std::min(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-            int gc2 = std::max(cartMapper_.cartesianIndex(elements.first), cartMapper_.cartesianIndex(elements.second));
-
-            // only adjust the NNCs
-            if (gc2 - gc1 == 1 || gc2 - gc1 == cartDims[0] || gc2 - gc1 == cartDims[0]*cartDims[1])
-                continue;
+    for (auto&& trans: trans_)
+        removeSmallNonCartesianTransmissibility_(trans.first, trans.second);
+}
 
-            //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
-            trans.second = 0.0;
-        }
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+removeSmallNonCartesianTransmissibility_(std::uint64_t id, Scalar& trans) const
+{
+    if (trans < transmissibilityThreshold_) {
+        const auto& elements = isIdReverse(id);
+
+        // only adjust the NNCs
+        if (isCartesianNeighbor_(cartMapper_.cartesianIndex(elements.first),
+                                 cartMapper_.cartesianIndex(elements.second)))
+            return;
+
+        //remove transmissibilities less than the threshold (by default 1e-6 in the deck's unit system)
+        trans = 0.0;
     }
 }
 
@@ -581,7 +698,7 @@ applyAllZMultipliers_(Scalar& trans,
                       unsigned outsideCartElemIdx,
                       const TransMult& transMult,
                       const std::array<int, dimWorld>& cartDims,
-                      bool pinchTop)
+                      bool pinchTop) const
 {
     if (insideFaceIdx > 3) { // top or or bottom
         assert(insideFaceIdx==5); // as insideCartElemIdx < outsideCartElemIdx holds for the Z column
@@ -856,6 +973,8 @@ applyNncToGridTrans_(const std::vector<int>& cartesianToCompressed)
             // set or computed.
             candidate->second += nncEntry.trans;
             processedNnc.push_back(nncEntry);
+            if (recordMultiplierFaces_)
+                nncModifiedFaces_.insert(candidate->first);
         }
     }
     return std::make_tuple(processedNnc, unprocessedNnc);
@@ -910,6 +1029,8 @@ applyEditNncToGridTrans_(const std::vector<int>& globalToLocal)
         }
         else {
             // NNC exists
+            if (recordMultiplierFaces_)
+                nncModifiedFaces_.insert(candidate->first);
             while (nnc!= end && c1==nnc->cell1 && c2==nnc->cell2) {
                 candidate->second *= nnc->trans;
                 ++nnc;
@@ -34,10 +34,14 @@
 #include <dune/common/fmatrix.hh>
 
 #include <array>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Opm {
 
@@ -68,6 +72,15 @@ public:
     const DimMatrix& permeability(unsigned elemIdx) const
     { return permeability_[elemIdx]; }
 
+    /*!
+     * \brief Set a multiplier of the intrinsic permeability for each element.
+     *
+     * The multipliers take effect with the next call to update(). An empty
+     * vector removes the multipliers.
+     */
+    void setPermeabilityMultipliers(std::vector<Scalar> multipliers)
+    { permeabilityMultipliers_ = std::move(multipliers); }
+
     /*!
      * \brief Return the transmissibility for the intersection between two elements.
      */
@@ -126,11 +139,56 @@ public:
      */
     void update(bool global);
 
+    /*!
+     * \brief Recompute the transmissibilities after the multipliers changed.
+     *
+     * Only the multipliers of the faces are re-evaluated (MULT{XYZ}, MULTFLT,
+     * MULTREGT), and only faces whose multiplied transmissibility changed are
+     * updated. The first call does a full update() and records the data
+     * needed for the following calls. A full update() is also done if the
+     * transmissibilities are modified by TRAN{XYZ} or if a changed face is
+     * also modified by NNC or EDITNNC.
+     *
+     * \param global If true, update is called on all processes
+     * \return The pairs of element indices whose transmissibility changed,
+     *         or std::nullopt if a full update was done.
+     */
+    std::optional<std::vector<std::pair<unsigned, unsigned>>>
+    updateMultipliers(bool global);
+
 protected:
+    /// \brief Data of a face needed to re-apply the transmissibility multipliers.
+    struct MultiplierFace
+    {
+        std::uint64_t id;
+        unsigned insideElemIdx;
+        unsigned outsideElemIdx;
+        unsigned insideCartElemIdx;
+        unsigned outsideCartElemIdx;
+        int insideFaceIdx;
+        int outsideFaceIdx;
+        Scalar unmultipliedTrans; //!< Harmonic mean of the half transmissibilities
+        Scalar trans; //!< Transmissibility after applying the multipliers
+    };
+
+    /// \brief Apply the cell face and region multipliers to a face transmissibility.
+    void applyFaceMultipliers_(Scalar& trans,
+                               int insideFaceIdx,
+                               int outsideFaceIdx,
+                               unsigned insideCartElemIdx,
+                               unsigned outsideCartElemIdx,
+                               const TransMult& transMult,
+                               const std::array<int, dimWorld>& cartDims) const;
+
+    bool isCartesianNeighbor_(unsigned cartElemIdx1, unsigned cartElemIdx2) const;
+
     void updateFromEclState_(bool global);
 
     void removeSmallNonCartesianTransmissibilities_();
 
+    /// \brief Remove a transmissibility of an NNC which is below the threshold.
+    void removeSmallNonCartesianTransmissibility_(std::uint64_t id, Scalar& trans) const;
+
     /// \brief Apply the Multipliers for the case PINCH(4)==TOPBOT
     ///
     /// \param pinchTop Whether PINCH(5) is TOP, otherwise ALL is assumed.
@@ -141,7 +199,7 @@ protected:
                                unsigned outsideCartElemIdx,
                                const TransMult& transMult,
                                const std::array<int, dimWorld>& cartDims,
-                               bool pinchTop);
+                               bool pinchTop) const;
 
     /// \brief Creates TRANS{XYZ} arrays for modification by FieldProps data
     ///
@@ -230,6 +288,7 @@ protected:
                    const std::vector<double>& ntg) const;
 
     std::vector<DimMatrix> permeability_;
+    std::vector<Scalar> permeabilityMultipliers_;
     std::vector<Scalar> porosity_;
     std::unordered_map<std::uint64_t, Scalar> trans_;
     const EclipseState& eclState_;
@@ -244,6 +303,11 @@ protected:
     bool enableDiffusivity_;
     std::unordered_map<std::uint64_t, Scalar> thermalHalfTrans_;
     std::unordered_map<std::uint64_t, Scalar> diffusivity_;
+
+    bool useSmallestMultiplier_ = false;
+    bool recordMultiplierFaces_ = false;
+    std::vector<MultiplierFace> multiplierFaces_;
+    std::unordered_set<std::uint64_t> nncModifiedFaces_;
 };
 
 } // namespace Opm
@@ -50,8 +50,11 @@
 
 #include <dune/grid/common/gridenums.hh>
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 #include <unordered_set>
+#include <utility>
 #include <string>
 #include <vector>
 
@@ -140,7 +143,8 @@ public:
         computeWellConnectionsMap_(episodeIdx, wellCompMap);
 
         if (wasRestarted || wellTopologyChanged_(eclState, deckSchedule, episodeIdx))
-            updateWellTopology_(episodeIdx, wellCompMap, gridDofIsPenetrated_);
+            updateWellTopology_(episodeIdx, wellCompMap, gridDofIsPenetrated_,
+                                gridDofWellOffsets_, gridDofWells_);
 
         // set those parameters of the wells which do not change the topology of the
         // linearized system of equations
@@ -518,16 +522,17 @@ public:
     {
         q = 0.0;
 
-        if (!gridDofIsPenetrated(context.globalSpaceIndex(dofIdx, timeIdx)))
+        const unsigned globalDofIdx = context.globalSpaceIndex(dofIdx, timeIdx);
+        if (!gridDofIsPenetrated(globalDofIdx))
             return;
 
         RateVector wellRate;
 
-        // iterate over all wells and add up their individual rates
-        const size_t wellSize = wells_.size();
-        for (size_t wellIdx = 0; wellIdx < wellSize; ++wellIdx) {
+        // iterate over the wells penetrating the DOF and add up their individual rates
+        for (unsigned i = gridDofWellOffsets_[globalDofIdx];
+             i < gridDofWellOffsets_[globalDofIdx + 1]; ++i) {
             wellRate = 0.0;
-            wells_[wellIdx]->computeTotalRatesForDof(wellRate, context, dofIdx, timeIdx);
+            wells_[gridDofWells_[i]]->computeTotalRatesForDof(wellRate, context, dofIdx, timeIdx);
             for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
                 q[eqIdx] += wellRate[eqIdx];
         }
@@ -704,7 +709,9 @@ protected:
 
     void updateWellTopology_(unsigned reportStepIdx OPM_UNUSED,
                              const WellConnectionsMap& wellConnections,
-                             std::vector<bool>& gridDofIsPenetrated) const
+                             std::vector<bool>& gridDofIsPenetrated,
+                             std::vector<unsigned>& gridDofWellOffsets,
+                             std::vector<unsigned>& gridDofWells) const
     {
         auto& model = simulator_.model();
         const auto& vanguard = simulator_.vanguard();
@@ -724,6 +731,7 @@ protected:
 
         gridDofIsPenetrated.resize(model.numGridDof());
         std::fill(gridDofIsPenetrated.begin(), gridDofIsPenetrated.end(), false);
+        std::vector<std::pair<unsigned, unsigned>> dofWellPairs;
 
         ElementContext elemCtx(simulator_);
         auto elemIt = gridView.template begin</*codim=*/0>();
@@ -750,10 +758,24 @@ protected:
                 eclWell->addDof(elemCtx, dofIdx);
 
                 wells.insert(eclWell);
+                dofWellPairs.emplace_back(globalDofIdx, wellIndex(eclWell->name()));
             }
             //////
         }
 
+        // compressed map from grid DOFs to the indices of the wells penetrating them
+        std::sort(dofWellPairs.begin(), dofWellPairs.end());
+        dofWellPairs.erase(std::unique(dofWellPairs.begin(), dofWellPairs.end()),
+                           dofWellPairs.end());
+        gridDofWellOffsets.assign(model.numGridDof() + 1, 0);
+        gridDofWells.resize(dofWellPairs.size());
+        for (size_t i = 0; i < dofWellPairs.size(); ++i) {
+            ++gridDofWellOffsets[dofWellPairs[i].first + 1];
+            gridDofWells[i] = dofWellPairs[i].second;
+        }
+        std::partial_sum(gridDofWellOffsets.begin(), gridDofWellOffsets.end(),
+                         gridDofWellOffsets.begin());
+
         // register all wells at the model as auxiliary equations
         wellIt = wells_.begin();
         for (; wellIt != wellEndIt; ++wellIt) {
@@ -871,6 +893,9 @@ protected:
 
     std::vector<std::shared_ptr<Well> > wells_;
     std::vector<bool> gridDofIsPenetrated_;
+    // CSR map from grid DOFs to the indices of the wells penetrating them
+    std::vector<unsigned> gridDofWellOffsets_;
+    std::vector<unsigned> gridDofWells_;
     std::map<std::string, int> wellNameToIndex_;
     std::map<std::string, std::array<Scalar, numPhases> > wellTotalInjectedVolume_;
     std::map<std::string, std::array<Scalar, numPhases> > wellTotalProducedVolume_;
@@ -31,13 +31,17 @@
 #include "collecttoiorank.hh"
 #include "ecloutputblackoilmodule.hh"
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
 
 #include <ebos/eclgenericwriter.hh>
 
+#include <optional>
 #include <string>
+#include <tuple>
 
 namespace Opm::Properties {
 
@@ -239,6 +243,9 @@ public:
 
             // add cell data to perforations for Rft output
             this->eclOutputModule_->addRftDataToWells(localWellData, reportStepNum);
+
+            // some of the cell data has been handed over above
+            this->preparedCellData_.reset();
         }
 
         if (this->collectToIORank_.isParallel()) {
@@ -361,6 +368,15 @@ private:
     void prepareLocalCellData(const bool isSubStep,
                               const int  reportStepNum)
     {
+        // The summary evaluation and the output of a step see the same
+        // solution, so the cell data is only computed once for both.
+        const auto state = std::make_tuple(reportStepNum, isSubStep,
+                                           simulator_.timeStepIndex(),
+                                           simulator_.time(),
+                                           simulator_.timeStepSize());
+        if (this->preparedCellData_ == state)
+            return;
+
         const auto& gridView = simulator_.vanguard().gridView();
         const int numElements = gridView.size(/*codim=*/0);
         const bool log = this->collectToIORank_.isIORank();
@@ -368,23 +384,34 @@ private:
         eclOutputModule_->allocBuffers(numElements, reportStepNum,
                                       isSubStep, log, /*isRestart*/ false);
 
-        ElementContext elemCtx(simulator_);
-        ElementIterator elemIt = gridView.template begin</*codim=*/0>();
-
-        const ElementIterator& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
+        // Every element only writes its own entries of the output buffers,
+        // so the elements can be processed concurrently.
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            ElementIterator elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                const Element& elem = *elemIt;
 
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                elemCtx.updatePrimaryStencil(elem);
+                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
-            eclOutputModule_->processElement(elemCtx);
+                eclOutputModule_->processElement(elemCtx);
+            }
         }
+        eclOutputModule_->processSaturatedPvt();
+
+        this->preparedCellData_ = state;
     }
 
     Simulator& simulator_;
     std::unique_ptr<EclOutputBlackOilModule<TypeTag>> eclOutputModule_;
     Scalar restartTimeStepSize_;
+    //! \brief Step for which the local cell data was computed last.
+    std::optional<std::tuple<int, bool, int, Scalar, Scalar>> preparedCellData_;
 };
 } // namespace Opm
 
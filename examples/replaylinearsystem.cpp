@@ -0,0 +1,279 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Solve a linear system written by flow with --linear-solver-write-snapshot=true
+// again, and report the time spent in the setup of the solver, the update of
+// the preconditioner and the solve itself.
+//
+// Usage: replaylinearsystem <snapshot> [--settings=<file.json>] [--repeat=<n>]
+//
+// <snapshot> is the file of one of the processes, e.g.
+// reports/prob_3_time_..._nit_2_system_0.osys. When run on several processes,
+// which must be as many as in the run that wrote the snapshot, every process
+// reads the file with its own rank. The solver settings stored in the
+// snapshot are used unless others are given with --settings.
+
+#include <config.h>
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemSnapshot.hpp>
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/WellOperators.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/schwarz.hh>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct ReplayOptions
+{
+    std::string snapshot;
+    std::optional<std::string> settings;
+    int repeat = 1;
+};
+
+std::string snapshotOfRank(const std::string& snapshot, const int rank, const int size)
+{
+    const std::string suffix = ".osys";
+    const auto underscore = snapshot.rfind('_');
+    const bool hasRank = underscore != std::string::npos
+        && snapshot.size() > suffix.size()
+        && snapshot.compare(snapshot.size() - suffix.size(), suffix.size(), suffix) == 0;
+    if (!hasRank) {
+        if (size > 1) {
+            throw std::invalid_argument("Cannot find the snapshots of the other processes from " + snapshot);
+        }
+        return snapshot;
+    }
+    return snapshot.substr(0, underscore + 1) + std::to_string(rank) + suffix;
+}
+
+template <class Comm>
+void printTimings(const Comm& comm, const std::string& name, const std::vector<double>& times)
+{
+    if (times.empty()) {
+        return;
+    }
+    const double localMin = *std::min_element(times.begin(), times.end());
+    double localMean = 0.0;
+    for (const double t : times) {
+        localMean += t;
+    }
+    localMean /= times.size();
+
+    // The slowest process determines the time of a parallel solve, the
+    // fastest one shows how much of that is load imbalance.
+    const double slowest = comm.max(localMean);
+    const double fastest = comm.min(localMean);
+    const double best = comm.max(localMin);
+    if (comm.rank() == 0) {
+        std::cout << std::left << std::setw(10) << name << std::right << std::scientific << std::setprecision(3)
+                  << "  mean " << slowest << " s"
+                  << "  best " << best << " s"
+                  << "  fastest process " << fastest << " s\n";
+    }
+}
+
+template <int bz>
+void replay(const ReplayOptions& options, const std::string& filename)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+    using Solver = Dune::FlexibleSolver<Matrix, Vector>;
+    using SeqWellOperator = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    auto snapshot = Opm::readLinearSystemSnapshot<Matrix, Vector>(filename);
+    if (snapshot.info.numRanks != comm.size()) {
+        throw std::invalid_argument("The snapshot was written by " + std::to_string(snapshot.info.numRanks)
+                                    + " processes, but the replay runs on " + std::to_string(comm.size()));
+    }
+
+    Opm::PropertyTree prm = snapshot.prm;
+    if (options.settings) {
+        prm = Opm::PropertyTree(*options.settings);
+    }
+
+    std::function<Vector()> weightsCalculator;
+    using namespace std::string_literals;
+    const auto preconditionerType = prm.get("preconditioner.type"s, "cpr"s);
+    if (preconditionerType == "cpr" || preconditionerType == "cprt") {
+        if (snapshot.weights) {
+            weightsCalculator = [&snapshot]() { return *snapshot.weights; };
+        } else {
+            const bool transpose = preconditionerType == "cprt";
+            weightsCalculator = [&snapshot, transpose, p = snapshot.info.pressureIndex]() {
+                return Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(snapshot.matrix, p, transpose);
+            };
+        }
+    }
+
+    std::unique_ptr<SeqWellOperator> wellOperator;
+    if (snapshot.wellMatrix) {
+        wellOperator = std::make_unique<SeqWellOperator>(*snapshot.wellMatrix);
+    }
+
+    std::unique_ptr<typename Solver::AbstractOperatorType> linearOperator;
+    std::unique_ptr<Solver> solver;
+    Dune::Timer timer;
+#if HAVE_MPI
+    using Comm = Dune::OwnerOverlapCopyCommunication<int, int>;
+    std::unique_ptr<Comm> parallelComm;
+    if (comm.size() > 1) {
+        parallelComm = std::make_unique<Comm>(Dune::MPIHelper::getCommunicator());
+        using LocalIndex = typename Comm::ParallelIndexSet::LocalIndex;
+        using Attribute = Dune::OwnerOverlapCopyAttributeSet::AttributeSet;
+        const auto& layout = snapshot.layout;
+        auto& indexSet = parallelComm->indexSet();
+        indexSet.beginResize();
+        for (std::size_t i = 0; i < layout.globalIndex.size(); ++i) {
+            if (layout.globalIndex[i] >= 0) {
+                indexSet.add(layout.globalIndex[i],
+                             LocalIndex(i, static_cast<Attribute>(layout.attribute[i]), layout.isPublic[i] != 0));
+            }
+        }
+        indexSet.endResize();
+        parallelComm->remoteIndices().template rebuild<false>();
+
+        if (wellOperator) {
+            using ParOperatorType = Opm::WellModelGhostLastMatrixAdapter<Matrix, Vector, Vector, true>;
+            linearOperator = std::make_unique<ParOperatorType>(snapshot.matrix, *wellOperator,
+                                                               snapshot.layout.interiorSize);
+        } else {
+            using ParOperatorType = Dune::OverlappingSchwarzOperator<Matrix, Vector, Vector, Comm>;
+            linearOperator = std::make_unique<ParOperatorType>(snapshot.matrix, *parallelComm);
+        }
+        timer.reset();
+        solver = std::make_unique<Solver>(*linearOperator, *parallelComm, prm, weightsCalculator,
+                                          snapshot.info.pressureIndex);
+    } else
+#endif
+    {
+        if (wellOperator) {
+            using SeqOperatorType = Opm::WellModelMatrixAdapter<Matrix, Vector, Vector, false>;
+            linearOperator = std::make_unique<SeqOperatorType>(snapshot.matrix, *wellOperator);
+        } else {
+            using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+            linearOperator = std::make_unique<SeqOperatorType>(snapshot.matrix);
+        }
+        timer.reset();
+        solver = std::make_unique<Solver>(*linearOperator, prm, weightsCalculator,
+                                          snapshot.info.pressureIndex);
+    }
+    const std::vector<double> setupTimes{timer.elapsed()};
+
+    std::vector<double> updateTimes;
+    std::vector<double> applyTimes;
+    Dune::InverseOperatorResult result;
+    for (int run = 0; run < options.repeat; ++run) {
+        if (run > 0) {
+            timer.reset();
+            solver->preconditioner().update();
+            updateTimes.push_back(timer.elapsed());
+        }
+        Vector x(snapshot.rhs.size());
+        x = 0.0;
+        Vector rhs = snapshot.rhs;
+        timer.reset();
+        solver->apply(x, rhs, result);
+        applyTimes.push_back(timer.elapsed());
+    }
+
+    if (comm.rank() == 0) {
+        std::cout << "Block size " << bz << ", " << comm.size() << " process(es), "
+                  << (snapshot.wellMatrix ? "wells as separate operator" : "wells in the matrix")
+                  << ", preconditioner " << preconditionerType << "\n"
+                  << "Iterations " << result.iterations
+                  << ", reduction " << result.reduction
+                  << (result.converged ? ", converged\n" : ", not converged\n");
+    }
+    printTimings(comm, "setup", setupTimes);
+    printTimings(comm, "update", updateTimes);
+    printTimings(comm, "apply", applyTimes);
+}
+
+ReplayOptions parseOptions(int argc, char** argv)
+{
+    ReplayOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--settings=", 0) == 0) {
+            options.settings = arg.substr(11);
+        } else if (arg.rfind("--repeat=", 0) == 0) {
+            options.repeat = std::max(1, std::stoi(arg.substr(9)));
+        } else if (options.snapshot.empty()) {
+            options.snapshot = arg;
+        } else {
+            throw std::invalid_argument("Unknown argument " + arg);
+        }
+    }
+    if (options.snapshot.empty()) {
+        throw std::invalid_argument("No snapshot given");
+    }
+    return options;
+}
+
+} // Anonymous namespace
+
+
+int main(int argc, char** argv)
+{
+    const auto& helper = Dune::MPIHelper::instance(argc, argv);
+    try {
+        const auto options = parseOptions(argc, argv);
+        const auto filename = snapshotOfRank(options.snapshot, helper.rank(), helper.size());
+        const auto info = Opm::readLinearSystemSnapshotInfo(filename);
+        switch (info.blockSize) {
+        case 1: replay<1>(options, filename); break;
+        case 2: replay<2>(options, filename); break;
+        case 3: replay<3>(options, filename); break;
+        case 4: replay<4>(options, filename); break;
+        default:
+            throw std::invalid_argument("Unsupported block size " + std::to_string(info.blockSize));
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n"
+                  << "Usage: " << argv[0] << " <snapshot> [--settings=<file.json>] [--repeat=<n>]\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
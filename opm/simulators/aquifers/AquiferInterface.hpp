@@ -108,23 +108,10 @@ public:
 
     void beginTimeStep()
     {
-        ElementContext elemCtx(ebos_simulator_);
-        auto elemIt = ebos_simulator_.gridView().template begin<0>();
-        const auto& elemEndIt = ebos_simulator_.gridView().template end<0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-
-            elemCtx.updatePrimaryStencil(elem);
-
-            const int cellIdx = elemCtx.globalSpaceIndex(0, 0);
-            const int idx = cellToConnectionIdx_[cellIdx];
-            if (idx < 0)
-                continue;
-
-            elemCtx.updateIntensiveQuantities(0);
-            const auto& iq = elemCtx.intensiveQuantities(0, 0);
+        this->forEachConnectedCell_([this](const int idx, const IntensiveQuantities& iq)
+        {
             pressure_previous_[idx] = getValue(iq.fluidState().pressure(waterPhaseIdx));
-        }
+        });
     }
 
     template <class Context>
@@ -182,6 +169,44 @@ protected:
         Qai_.resize(this->connections_.size(), 0.0);
     }
 
+    // Call fn(idx, intQuants) for the connections of the aquifer on this
+    // process. The cached intensive quantities of the model are used when
+    // they are up to date for all connected cells, otherwise they are
+    // computed by a sweep over the grid.
+    template <class Fn>
+    void forEachConnectedCell_(Fn&& fn) const
+    {
+        const auto& model = this->ebos_simulator_.model();
+        const bool cached = std::all_of(this->connectedCells_.begin(), this->connectedCells_.end(),
+                                        [&model](const int cellIdx)
+                                        {
+                                            return model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0) != nullptr;
+                                        });
+        if (cached) {
+            for (const int cellIdx : this->connectedCells_) {
+                fn(this->cellToConnectionIdx_[cellIdx],
+                   *model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0));
+            }
+            return;
+        }
+
+        ElementContext elemCtx(this->ebos_simulator_);
+        const auto& gridView = this->ebos_simulator_.gridView();
+        const auto& elemMapper = model.elementMapper();
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const auto& elem = *elemIt;
+            const int idx = this->cellToConnectionIdx_[elemMapper.index(elem)];
+            if (idx < 0)
+                continue;
+
+            elemCtx.updatePrimaryStencil(elem);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            fn(idx, elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0));
+        }
+    }
+
     inline void
     updateCellPressure(std::vector<Eval>& pressure_water, const int idx, const IntensiveQuantities& intQuants)
     {
@@ -205,6 +230,8 @@ protected:
     // Grid variables
     std::vector<Scalar> faceArea_connected_;
     std::vector<int> cellToConnectionIdx_;
+    // Cells of this process connected to the aquifer, in grid order.
+    std::vector<int> connectedCells_;
 
     // Quantities at each grid id
     std::vector<Scalar> cell_depth_;
@@ -233,6 +260,7 @@ protected:
         // denom_face_areas is the sum of the areas connected to an aquifer
         Scalar denom_face_areas = 0.;
         this->cellToConnectionIdx_.resize(this->ebos_simulator_.gridView().size(/*codim=*/0), -1);
+        this->connectedCells_.clear();
         const auto& gridView = this->ebos_simulator_.vanguard().gridView();
         for (size_t idx = 0; idx < this->size(); ++idx) {
             const auto global_index = this->connections_[idx].global_index;
@@ -246,8 +274,10 @@ protected:
                 continue;
 
             this->cellToConnectionIdx_[cell_index] = idx;
+            this->connectedCells_.push_back(cell_index);
             this->cell_depth_.at(idx) = this->ebos_simulator_.vanguard().cellCenterDepth(cell_index);
         }
+        std::sort(this->connectedCells_.begin(), this->connectedCells_.end());
         // get areas for all connections
         ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
         auto elemIt = gridView.template begin</*codim=*/ 0>();
@@ -331,26 +361,12 @@ protected:
     {
         // Since the global_indices are the reservoir index, we just need to extract the fluidstate at those indices
         std::vector<Scalar> pw_aquifer;
-        Scalar water_pressure_reservoir;
-
-        ElementContext elemCtx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            elemCtx.updatePrimaryStencil(elem);
 
-            const auto cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            const auto idx = this->cellToConnectionIdx_[cellIdx];
-            if (idx < 0)
-                continue;
-
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            const auto& iq0 = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
+        this->forEachConnectedCell_([this, &pw_aquifer](const int idx, const IntensiveQuantities& iq0)
+        {
             const auto& fs = iq0.fluidState();
 
-            water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
+            const Scalar water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
             const auto water_density = fs.density(waterPhaseIdx);
 
             const auto gdz =
@@ -358,7 +374,7 @@ protected:
 
             pw_aquifer.push_back(this->alphai_[idx] *
                 (water_pressure_reservoir - water_density.value()*gdz));
-        }
+        });
 
         // We take the average of the calculated equilibrium pressures.
         const auto& comm = ebos_simulator_.vanguard().grid().comm();
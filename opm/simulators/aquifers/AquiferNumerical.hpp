@@ -24,7 +24,9 @@
 #include <opm/output/data/Aquifer.hpp>
 #include <opm/parser/eclipse/EclipseState/Aquifer/NumericalAquifer/SingleNumericalAquifer.hpp>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -38,6 +40,7 @@ public:
     using BlackoilIndices = GetPropType<TypeTag, Properties::Indices>;
 
     using GridView = GetPropType<TypeTag, Properties::GridView>;
+    using ElementMapper = GetPropType<TypeTag, Properties::ElementMapper>;
     using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
 
     enum { dimWorld = GridView::dimensionworld };
@@ -72,6 +75,21 @@ public:
                 this->cell_to_aquifer_cell_idx_[search->second] = idx;
             }
         }
+
+        const auto& gridView = this->ebos_simulator_.gridView();
+        ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const auto& elem = *elemIt;
+            if (elem.partitionType() != Dune::InteriorEntity) {
+                continue;
+            }
+            const int cell_index = elemMapper.index(elem);
+            if (this->cell_to_aquifer_cell_idx_[cell_index] >= 0) {
+                this->interior_cells_.push_back(cell_index);
+            }
+        }
     }
 
     void initFromRestart([[maybe_unused]]const data::Aquifers& aquiferSoln)
@@ -123,6 +141,8 @@ private:
 
     // TODO: maybe unordered_map can also do the work to save memory?
     std::vector<int> cell_to_aquifer_cell_idx_;
+    // the aquifer cells which are interior to this process, in grid order
+    std::vector<int> interior_cells_;
 
     double calculateAquiferPressure() const
     {
@@ -135,25 +155,10 @@ private:
         double sum_pressure_watervolume = 0.;
         double sum_watervolume = 0.;
 
-        ElementContext  elem_ctx(this->ebos_simulator_);
-        const auto& gridView = this->ebos_simulator_.gridView();
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity) {
-                continue;
-            }
-            elem_ctx.updatePrimaryStencil(elem);
-
-            const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+        const auto& model = this->ebos_simulator_.model();
+        auto addCell = [&](const unsigned cell_index, const auto& iq0)
+        {
             const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            if (idx < 0) {
-                continue;
-            }
-
-            elem_ctx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            const auto& iq0 = elem_ctx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
             const auto& fs = iq0.fluidState();
 
             // TODO: the porosity of the cells are still wrong for numerical aquifer cells
@@ -161,7 +166,7 @@ private:
             // The pore volume is correct. Extra efforts will be done to get sensible porosity value here later.
             const double water_saturation = fs.saturation(waterPhaseIdx).value();
             const double porosity = iq0.porosity().value();
-            const double volume = elem_ctx.dofTotalVolume(0, 0);
+            const double volume = model.dofTotalVolume(cell_index);
             // TODO: not sure we should use water pressure here
             const double water_pressure_reservoir = fs.pressure(waterPhaseIdx).value();
             const double water_volume = volume * porosity * water_saturation;
@@ -169,6 +174,37 @@ private:
             sum_watervolume += water_volume;
 
             cell_pressure[idx] = water_pressure_reservoir;
+        };
+
+        const bool cached = std::all_of(this->interior_cells_.begin(), this->interior_cells_.end(),
+                                        [&model](const int cell_index)
+                                        {
+                                            return model.cachedIntensiveQuantities(cell_index, /*timeIdx=*/0) != nullptr;
+                                        });
+        if (cached) {
+            for (const int cell_index : this->interior_cells_) {
+                addCell(cell_index, *model.cachedIntensiveQuantities(cell_index, /*timeIdx=*/0));
+            }
+        }
+        else {
+            ElementContext  elem_ctx(this->ebos_simulator_);
+            const auto& gridView = this->ebos_simulator_.gridView();
+            auto elemIt = gridView.template begin</*codim=*/0>();
+            const auto& elemEndIt = gridView.template end</*codim=*/0>();
+            for (; elemIt != elemEndIt; ++elemIt) {
+                const auto& elem = *elemIt;
+                if (elem.partitionType() != Dune::InteriorEntity) {
+                    continue;
+                }
+                const unsigned cell_index = model.elementMapper().index(elem);
+                if (this->cell_to_aquifer_cell_idx_[cell_index] < 0) {
+                    continue;
+                }
+
+                elem_ctx.updatePrimaryStencil(elem);
+                elem_ctx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                addCell(cell_index, elem_ctx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0));
+            }
         }
 
         const auto& comm = this->ebos_simulator_.vanguard().grid().comm();
@@ -194,15 +230,15 @@ private:
             if (elem.partitionType() != Dune::InteriorEntity) {
                 continue;
             }
-            // elem_ctx.updatePrimaryStencil(elem);
-            elem_ctx.updateStencil(elem);
 
-            const size_t cell_index = elem_ctx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            // look the cell up before building the stencil, we only need the
+            // first aquifer cell
+            const size_t cell_index = this->ebos_simulator_.model().elementMapper().index(elem);
             const int idx = this->cell_to_aquifer_cell_idx_[cell_index];
-            // we only need the first aquifer cell
             if (idx != 0) {
                 continue;
             }
+            elem_ctx.updateStencil(elem);
             elem_ctx.updateAllIntensiveQuantities();
             elem_ctx.updateAllExtensiveQuantities();
 
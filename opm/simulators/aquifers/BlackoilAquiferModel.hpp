@@ -107,6 +107,17 @@ public:
     template <class Restarter>
     void deserialize(Restarter& res);
 
+    // In-memory copy of the aquifers, including their flux history.
+    struct Checkpoint
+    {
+        std::vector<AquiferCarterTracy<TypeTag>> carterTracy;
+        std::vector<AquiferFetkovich<TypeTag>> fetkovich;
+        std::vector<AquiferNumerical<TypeTag>> numerical;
+    };
+
+    Checkpoint checkpoint() const;
+    void restore(const Checkpoint& checkpoint);
+
 protected:
     // ---------      Types      ---------
     using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
@@ -94,14 +94,24 @@ template <typename TypeTag>
 void
 BlackoilAquiferModel<TypeTag>::beginTimeStep()
 {
+    // The analytic aquifers only read the state of their own connected
+    // cells here and do not communicate, so they are independent.
     if (aquiferCarterTracyActive()) {
-        for (auto& aquifer : aquifers_CarterTracy) {
-            aquifer.beginTimeStep();
+        const int numAquifers = aquifers_CarterTracy.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int aquIdx = 0; aquIdx < numAquifers; ++aquIdx) {
+            aquifers_CarterTracy[aquIdx].beginTimeStep();
         }
     }
     if (aquiferFetkovichActive()) {
-        for (auto& aquifer : aquifers_Fetkovich) {
-            aquifer.beginTimeStep();
+        const int numAquifers = aquifers_Fetkovich.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int aquIdx = 0; aquIdx < numAquifers; ++aquIdx) {
+            aquifers_Fetkovich[aquIdx].beginTimeStep();
         }
     }
 }
@@ -176,6 +186,33 @@ BlackoilAquiferModel<TypeTag>::deserialize(Restarter& /* res */)
     throw std::logic_error("BlackoilAquiferModel::deserialize() is not yet implemented");
 }
 
+template <typename TypeTag>
+typename BlackoilAquiferModel<TypeTag>::Checkpoint
+BlackoilAquiferModel<TypeTag>::checkpoint() const
+{
+    return Checkpoint{aquifers_CarterTracy, aquifers_Fetkovich, aquifers_numerical};
+}
+
+template <typename TypeTag>
+void
+BlackoilAquiferModel<TypeTag>::restore(const Checkpoint& checkpoint)
+{
+    // The aquifer objects hold references to the simulator, hence they can
+    // be copy constructed but not assigned.
+    auto copyAquifers = [](const auto& source, auto& target)
+    {
+        target.clear();
+        target.reserve(source.size());
+        for (const auto& aquifer : source) {
+            target.emplace_back(aquifer);
+        }
+    };
+
+    copyAquifers(checkpoint.carterTracy, aquifers_CarterTracy);
+    copyAquifers(checkpoint.fetkovich, aquifers_Fetkovich);
+    copyAquifers(checkpoint.numerical, aquifers_numerical);
+}
+
 // Initialize the aquifers in the deck
 template <typename TypeTag>
 void
@@ -35,6 +35,7 @@
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/wells/WellConnectionAuxiliaryModule.hpp>
 #include <opm/simulators/flow/countGlobalCells.hpp>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 
 #include <opm/grid/UnstructuredGrid.h>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
@@ -233,6 +234,9 @@ namespace Opm {
             // update the solution variables in ebos
             if ( timer.lastStepFailed() ) {
                 ebosSimulator_.model().updateFailed();
+                if (param_.use_time_step_rollback_) {
+                    ebosSimulator_.problem().timeStepRolledBack();
+                }
             } else {
                 ebosSimulator_.model().advanceTimeLevel();
             }
@@ -421,7 +425,10 @@ namespace Opm {
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
-            ebosSimulator_.model().linearizer().linearizeDomain();
+            {
+                ScopedPerformanceTimer timer(PerformanceTimers::ReservoirLinearization);
+                ebosSimulator_.model().linearizer().linearizeDomain();
+            }
             ebosSimulator_.problem().endIteration();
 
             return wellModel().lastReport();
@@ -559,6 +566,7 @@ namespace Opm {
                                                     // residual
 
             // if the solution is updated, the intensive quantities need to be recalculated
+            ScopedPerformanceTimer timer(PerformanceTimers::IntensiveQuantities);
             ebosSimulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
         }
 
@@ -774,11 +782,19 @@ namespace Opm {
             const int numComp = numEq;
             Vector R_sum(numComp, 0.0 );
             Vector maxCoeff(numComp, std::numeric_limits< Scalar >::lowest() );
-            const double pvSumLocal = localConvergenceData(R_sum, maxCoeff, B_avg);
+            double pvSumLocal = 0.0;
+            {
+                ScopedPerformanceTimer timer(PerformanceTimers::ConvergenceSweep);
+                pvSumLocal = localConvergenceData(R_sum, maxCoeff, B_avg);
+            }
 
             // compute global sum and max of quantities
-            const double pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
-                                                      R_sum, maxCoeff, B_avg);
+            double pvSum = 0.0;
+            {
+                ScopedPerformanceTimer timer(PerformanceTimers::ConvergenceReduction);
+                pvSum = convergenceReduction(grid_.comm(), pvSumLocal,
+                                             R_sum, maxCoeff, B_avg);
+            }
 
             auto cnvErrorPvFraction = computeCnvErrorPv(B_avg, dt);
             cnvErrorPvFraction /= pvSum;
@@ -967,6 +983,21 @@ namespace Opm {
             return convergence_reports_;
         }
 
+        /// CNV residuals by component of all nonlinear iterations of the current step.
+        const std::vector<std::vector<double>>& residualNormsHistory() const
+        {
+            return residual_norms_history_;
+        }
+
+        /// The CNV tolerance a step has to reach when it is allowed maxIter
+        /// nonlinear iterations, i.e. the relaxed one if it applies by then.
+        double convergenceTargetCnv(const int maxIter) const
+        {
+            return maxIter >= param_.max_strict_iter_
+                ? std::max(param_.tolerance_cnv_, param_.tolerance_cnv_relaxed_)
+                : param_.tolerance_cnv_;
+        }
+
     protected:
         // ---------  Data members  ---------
 
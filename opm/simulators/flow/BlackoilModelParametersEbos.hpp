@@ -104,6 +104,10 @@ struct MatrixAddWellContributions {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct UseTimeStepRollback {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct EnableWellOperabilityCheck {
     using type = UndefinedProperty;
 };
@@ -233,6 +237,10 @@ struct MatrixAddWellContributions<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
 template<class TypeTag>
+struct UseTimeStepRollback<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct TolerancePressureMsWells<TypeTag, TTag::FlowModelParameters> {
     using type = GetPropType<TypeTag, Scalar>;
     static constexpr type value = 0.01*1e5;
@@ -387,6 +395,10 @@ namespace Opm
         // Whether to add influences of wells between cells to the matrix and preconditioner matrix
         bool matrix_add_well_contributions_;
 
+        /// Whether to skip the update of the history dependent quantities when
+        /// a failed time step is retried from the same solution.
+        bool use_time_step_rollback_;
+
         /// Construct from user parameters or defaults.
         BlackoilModelParametersEbos()
         {
@@ -417,6 +429,7 @@ namespace Opm
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
+            use_time_step_rollback_ = EWOMS_GET_PARAM(TypeTag, bool, UseTimeStepRollback);
 
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
         }
@@ -452,6 +465,7 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, UseTimeStepRollback, "Do not update the history dependent quantities (hysteresis, VAPPARS, ROCKCOMP) again when a failed time step is retried, which saves one update of the intensive quantities");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
         }
     };
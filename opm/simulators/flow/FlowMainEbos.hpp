@@ -395,6 +395,14 @@ namespace Opm
             return ebosSimulator_.get();
         }
 
+        Simulator *getFlowSimulatorPtr() {
+            return simulator_.get();
+        }
+
+        SimulatorTimer *getSimulatorTimerPtr() {
+            return simtimer_.get();
+        }
+
     private:
         // called by execute() or executeInitStep()
         int execute_(int (FlowMainEbos::* runOrInitFunc)(), bool cleanup)
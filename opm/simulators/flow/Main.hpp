@@ -466,7 +466,9 @@ namespace Opm
 
                 readDeck(mpiRank, deckFilename, deck_, eclipseState_, schedule_, udqState_,
                          summaryConfig_, nullptr, python, std::move(parseContext),
-                         init_from_restart_file, outputCout_, outputInterval);
+                         init_from_restart_file, outputCout_, outputInterval,
+                         EWOMS_GET_PARAM(PreTypeTag, std::string, DeckCache),
+                         EWOMS_GET_PARAM(PreTypeTag, bool, NodeSharedBroadcast));
 
                 setupTime_ = externalSetupTimer.elapsed();
                 outputFiles_ = (outputMode != FileOutputMode::OUTPUT_NONE);
@@ -33,6 +33,9 @@
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace Opm::Properties {
@@ -57,6 +60,14 @@ template<class TypeTag, class MyTypeTag>
 struct NewtonRelaxationType{
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct NewtonPredictFailure {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NewtonPredictFailureMinIterations {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct NewtonMaxRelax<TypeTag, TTag::FlowNonLinearSolver> {
@@ -75,6 +86,14 @@ template<class TypeTag>
 struct NewtonRelaxationType<TypeTag, TTag::FlowNonLinearSolver> {
     static constexpr auto value = "dampen";
 };
+template<class TypeTag>
+struct NewtonPredictFailure<TypeTag, TTag::FlowNonLinearSolver> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
+struct NewtonPredictFailureMinIterations<TypeTag, TTag::FlowNonLinearSolver> {
+    static constexpr int value = 3;
+};
 
 } // namespace Opm::Properties
 
@@ -105,6 +124,8 @@ class WellState;
             double relaxRelTol_;
             int maxIter_; // max nonlinear iterations
             int minIter_; // min nonlinear iterations
+            bool predictFailure_; // give up steps that are not going to converge
+            int predictFailureMinIter_; // iterations before a failure may be predicted
 
             SolverParameters()
             {
@@ -115,6 +136,8 @@ class WellState;
                 relaxMax_ = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonMaxRelax);
                 maxIter_ = EWOMS_GET_PARAM(TypeTag, int, FlowNewtonMaxIterations);
                 minIter_ = EWOMS_GET_PARAM(TypeTag, int, FlowNewtonMinIterations);
+                predictFailure_ = EWOMS_GET_PARAM(TypeTag, bool, NewtonPredictFailure);
+                predictFailureMinIter_ = std::max(EWOMS_GET_PARAM(TypeTag, int, NewtonPredictFailureMinIterations), 2);
 
                 const auto& relaxationTypeString = EWOMS_GET_PARAM(TypeTag, std::string, NewtonRelaxationType);
                 if (relaxationTypeString == "dampen") {
@@ -132,6 +155,8 @@ class WellState;
                 EWOMS_REGISTER_PARAM(TypeTag, int, FlowNewtonMaxIterations, "The maximum number of Newton iterations per time step used by flow");
                 EWOMS_REGISTER_PARAM(TypeTag, int, FlowNewtonMinIterations, "The minimum number of Newton iterations per time step used by flow");
                 EWOMS_REGISTER_PARAM(TypeTag, std::string, NewtonRelaxationType, "The type of relaxation used by flow's Newton method");
+                EWOMS_REGISTER_PARAM(TypeTag, bool, NewtonPredictFailure, "Give up a time step as soon as the convergence rate of the Newton method shows that it will not converge within the maximum number of iterations");
+                EWOMS_REGISTER_PARAM(TypeTag, int, NewtonPredictFailureMinIterations, "The number of Newton iterations before a convergence failure may be predicted (at least 2)");
             }
 
             void reset()
@@ -143,6 +168,8 @@ class WellState;
                 relaxRelTol_ = 0.2;
                 maxIter_ = 10;
                 minIter_ = 1;
+                predictFailure_ = false;
+                predictFailureMinIter_ = 3;
             }
 
         };
@@ -214,6 +241,18 @@ class WellState;
                     failureReport_ += model_->failureReport();
                     throw;
                 }
+
+                // Give up early rather than spending the remaining iterations on a
+                // step that is going to be chopped anyway.
+                if (!converged && param_.predictFailure_
+                    && iteration >= param_.predictFailureMinIter_ && iteration <= maxIter()
+                    && convergenceUnlikely(model_->residualNormsHistory(), iteration - 1)) {
+                    failureReport_ = report;
+
+                    std::string msg = "Solver convergence failure - Convergence within " + std::to_string(maxIter())
+                        + " iterations is unlikely after " + std::to_string(iteration) + " iterations.";
+                    OPM_THROW_NOLOG(TooManyIterations, msg);
+                }
             }
             while ( (!converged && (iteration <= maxIter())) || (iteration <= minIter()));
 
@@ -309,6 +348,54 @@ class WellState;
         }
 
 
+        /// Predict from the residual history whether the current step will converge
+        /// within maxIter() iterations. The worst CNV residual relative to the
+        /// tolerance is assumed to keep contracting at the rate of the last two
+        /// iterations; oscillating iterations are given less room since the
+        /// relaxation is going to slow them down further. Residuals which do
+        /// not contract at all are only given up on if they did not contract
+        /// at the previous check either.
+        bool convergenceUnlikely(const std::vector<std::vector<double>>& residualHistory,
+                                 const int it) const
+        {
+            if (it < 2) {
+                return false;
+            }
+
+            const double target = model_->convergenceTargetCnv(maxIter());
+            auto worstError = [&residualHistory, target](const int i) {
+                const auto& norms = residualHistory[i];
+                return norms.empty() ? 0.0 : *std::max_element(norms.begin(), norms.end()) / target;
+            };
+            const double e0 = worstError(it);
+            const double e2 = worstError(it - 2);
+            if (!(e0 > 1.0) || !(e2 > 0.0)) {
+                return false;
+            }
+
+            const double rate = std::sqrt(e0 / e2);
+            if (!(rate < 1.0)) {
+                // Not contracting at all. The residuals often grow for a few
+                // iterations after well control switches or phase appearance, so
+                // only give up if they did not contract at the previous check
+                // either.
+                if (it < 3) {
+                    return false;
+                }
+                const double e1 = worstError(it - 1);
+                const double e3 = worstError(it - 3);
+                return e3 > 0.0 && !(e1 < e3);
+            }
+
+            bool oscillate = false;
+            bool stagnate = false;
+            detectOscillations(residualHistory, it, oscillate, stagnate);
+            const double slack = oscillate ? 1.0 : 2.0;
+            const double needed = std::log(e0) / -std::log(rate);
+            return needed > slack * (maxIter() - it);
+        }
+
+
         /// Apply a stabilization to dx, depending on dxOld and relaxation parameters.
         /// Implemention for Dune block vectors.
         template <class BVector>
@@ -0,0 +1,126 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SIMULATOR_CHECKPOINT_HEADER_INCLUDED
+#define OPM_SIMULATOR_CHECKPOINT_HEADER_INCLUDED
+
+#include <ebos/eclproblem.hh>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Action/State.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQState.hpp>
+
+#include <array>
+
+namespace Opm {
+
+/// In-memory checkpoint of the dynamic state of a simulation.
+///
+/// The checkpoint holds everything needed to continue a simulation from
+/// the point where it was taken: the primary variables, the time and
+/// episode of the simulator, the history dependent state of the problem
+/// (hysteresis, maximum saturations, DRSDT trackers and tracers), the well
+/// and group states, the aquifers and the summary, UDQ and action states
+/// used by the schedule. Taking and restoring a checkpoint only copies
+/// memory, so one process may branch a simulation several times from the
+/// same state.
+///
+/// Changes the actions have made to the Schedule are not rolled back.
+template<class TypeTag>
+class SimulatorCheckpoint
+{
+public:
+    using Simulator = GetPropType<TypeTag, Properties::Simulator>;
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    using WellModel = GetPropType<TypeTag, Properties::EclWellModel>;
+    using AquiferModel = GetPropType<TypeTag, Properties::EclAquiferModel>;
+
+    /// Take a checkpoint of the current state of the simulator.
+    explicit SimulatorCheckpoint(const Simulator& simulator)
+        : solution_{simulator.model().solution(/*timeIdx=*/0),
+                    simulator.model().solution(/*timeIdx=*/1)}
+        , time_(simulator.time())
+        , timeStepSize_(simulator.timeStepSize())
+        , timeStepIndex_(simulator.timeStepIndex())
+        , episodeIndex_(simulator.episodeIndex())
+        , episodeStartTime_(simulator.episodeStartTime())
+        , episodeLength_(simulator.episodeLength())
+        , problem_(simulator.problem().checkpoint())
+        , wells_(simulator.problem().wellModel().checkpoint())
+        , aquifers_(simulator.problem().aquiferModel().checkpoint())
+        , summaryState_(simulator.vanguard().summaryState())
+        , udqState_(simulator.vanguard().udqState())
+        , actionState_(simulator.vanguard().actionState())
+    {}
+
+    /// Reset the simulator to the state of the checkpoint.
+    ///
+    /// The intensive quantities of the current time level are updated
+    /// from the restored solution.
+    void restore(Simulator& simulator) const
+    {
+        simulator.startNextEpisode(episodeStartTime_, episodeLength_);
+        simulator.setEpisodeIndex(episodeIndex_);
+        simulator.setTime(time_, timeStepIndex_);
+        simulator.setTimeStepSize(timeStepSize_);
+
+        auto& vanguard = simulator.vanguard();
+        vanguard.summaryState() = summaryState_;
+        vanguard.udqState() = udqState_;
+        vanguard.actionState() = actionState_;
+
+        auto& problem = simulator.problem();
+        problem.restore(problem_);
+        problem.wellModel().restore(wells_);
+        problem.mutableAquiferModel().restore(aquifers_);
+
+        auto& model = simulator.model();
+        model.solution(/*timeIdx=*/0) = solution_[0];
+        model.solution(/*timeIdx=*/1) = solution_[1];
+        model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    }
+
+    /// Time of the simulator when the checkpoint was taken.
+    Scalar time() const
+    { return time_; }
+
+private:
+    std::array<SolutionVector, 2> solution_;
+
+    Scalar time_;
+    Scalar timeStepSize_;
+    int timeStepIndex_;
+    int episodeIndex_;
+    Scalar episodeStartTime_;
+    Scalar episodeLength_;
+
+    typename Problem::Checkpoint problem_;
+    typename WellModel::Checkpoint wells_;
+    typename AquiferModel::Checkpoint aquifers_;
+
+    SummaryState summaryState_;
+    UDQState udqState_;
+    Action::State actionState_;
+};
+
+} // namespace Opm
+
+#endif // OPM_SIMULATOR_CHECKPOINT_HEADER_INCLUDED
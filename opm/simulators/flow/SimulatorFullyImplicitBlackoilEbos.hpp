@@ -28,11 +28,14 @@
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <fmt/format.h>
+
 namespace Opm::Properties {
 
 template<class TypeTag, class MyTypeTag>
@@ -43,6 +46,14 @@ template<class TypeTag, class MyTypeTag>
 struct EnableTuning {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct LoadImbalanceThreshold {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EnablePerformanceTimers {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct EnableTerminalOutput<TypeTag, TTag::EclFlowProblem> {
@@ -56,6 +67,14 @@ template<class TypeTag>
 struct EnableTuning<TypeTag, TTag::EclFlowProblem> {
     static constexpr bool value = false;
 };
+template<class TypeTag>
+struct LoadImbalanceThreshold<TypeTag, TTag::EclFlowProblem> {
+    static constexpr double value = 0.0;
+};
+template<class TypeTag>
+struct EnablePerformanceTimers<TypeTag, TTag::EclFlowProblem> {
+    static constexpr bool value = false;
+};
 
 } // namespace Opm::Properties
 
@@ -122,6 +141,8 @@ public:
         const auto& comm = grid().comm();
         terminalOutput_ = EWOMS_GET_PARAM(TypeTag, bool, EnableTerminalOutput);
         terminalOutput_ = terminalOutput_ && (comm.rank() == 0);
+        loadImbalanceThreshold_ = EWOMS_GET_PARAM(TypeTag, double, LoadImbalanceThreshold);
+        PerformanceTimers::enable(EWOMS_GET_PARAM(TypeTag, bool, EnablePerformanceTimers));
     }
 
     static void registerParameters()
@@ -136,6 +157,12 @@ public:
                              "Use adaptive time stepping between report steps");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTuning,
                              "Honor some aspects of the TUNING keyword.");
+        EWOMS_REGISTER_PARAM(TypeTag, double, LoadImbalanceThreshold,
+                             "Ratio of the maximum to the mean linearization time of the processes in a report step "
+                             "above which the cell costs of the step are recorded for the next partitioning (0: never)");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnablePerformanceTimers,
+                             "Time the hot paths of the simulator on each process and report the minimum, mean "
+                             "and maximum over the processes at the end of the run");
     }
 
     /// Run the simulation.
@@ -279,6 +306,8 @@ public:
         // update timing.
         report_.success.solver_time += solverTimer_->secsSinceStart();
 
+        checkLoadImbalance_(timer);
+
         // Increment timer, remember well state.
         ++timer;
 
@@ -309,17 +338,51 @@ public:
             report_.success.output_write_time += finalOutputTimer.stop();
         }
 
+        // The linearization is the part of the run whose time depends only
+        // on the cells of a process, the rest waits for the others. If a
+        // report step was found to be imbalanced, its statistics have been
+        // written instead.
+        if (!imbalancedStepRecorded_) {
+            ebosSimulator_.vanguard().writeCellCostStatistics(linearizationTime_());
+        }
+
         // Stop timer and create timing report
         totalTimer_->stop();
         report_.success.total_time = totalTimer_->secsSinceStart();
         report_.success.converged = true;
 
+        if (PerformanceTimers::enabled()) {
+            const auto& s = report_.success;
+            const auto& f = report_.failure;
+            const auto table = PerformanceTimers::report(grid().comm(), {
+                    {"Assembly", s.assemble_time + f.assemble_time},
+                    {"Linear solve setup", s.linear_solve_setup_time + f.linear_solve_setup_time},
+                    {"Linear solve", s.linear_solve_time + f.linear_solve_time},
+                    {"Update", s.update_time + f.update_time},
+                    {"Output write", s.output_write_time},
+                    {"Total", s.total_time}});
+            if (!table.empty()) {
+                OpmLog::info("\nTiming of the hot paths per process:\n" + table);
+            }
+        }
+
         return report_;
     }
 
     const Grid& grid() const
     { return ebosSimulator_.vanguard().grid(); }
 
+    /// Size of the next time step suggested by the adaptive time stepping,
+    /// or a negative value if adaptive time stepping is disabled.
+    double suggestedNextStep() const
+    { return adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0; }
+
+    void setSuggestedNextStep(const double dt)
+    {
+        if (adaptiveTimeStepping_)
+            adaptiveTimeStepping_->setSuggestedNextStep(dt);
+    }
+
 protected:
 
     std::unique_ptr<Solver> createSolver(WellModel& wellModel)
@@ -351,6 +414,44 @@ protected:
     const WellModel& wellModel_() const
     { return ebosSimulator_.problem().wellModel(); }
 
+    double linearizationTime_() const
+    { return report_.success.assemble_time + report_.failure.assemble_time; }
+
+    // The distribution of the grid cannot be changed once it is load
+    // balanced. Instead, the cell costs of a report step in which the
+    // linearization times of the processes differ by more than the
+    // threshold are recorded, so that a restart from that step can be
+    // partitioned by them.
+    void checkLoadImbalance_(const SimulatorTimer& timer)
+    {
+        const double stepTime = linearizationTime_() - lastLinearizationTime_;
+        lastLinearizationTime_ = linearizationTime_();
+
+        const auto& comm = grid().comm();
+        if (loadImbalanceThreshold_ <= 0.0 || comm.size() == 1)
+            return;
+
+        const double maxTime = comm.max(stepTime);
+        const double meanTime = comm.sum(stepTime) / comm.size();
+        if (!(meanTime > 0.0) || maxTime <= loadImbalanceThreshold_ * meanTime)
+            return;
+
+        const auto& statisticsFile = ebosSimulator_.vanguard().cellCostStatisticsFile();
+        if (terminalOutput_) {
+            std::string msg = fmt::format("Load imbalance in report step {}: the slowest process "
+                                          "spent {:.2f} times the mean linearization time of {:.3g} seconds.",
+                                          timer.currentStepNum(), maxTime / meanTime, meanTime);
+            if (statisticsFile.empty())
+                msg += " Set --partition-cost-statistics-file to record the cell costs for repartitioning.";
+            else
+                msg += " The cell costs are recorded in " + statisticsFile
+                    + ", restart with --partition-cell-costs=true to repartition.";
+            OpmLog::warning(msg);
+        }
+        ebosSimulator_.vanguard().writeCellCostStatistics(stepTime);
+        imbalancedStepRecorded_ = true;
+    }
+
     // Data.
     Simulator& ebosSimulator_;
     std::unique_ptr<WellConnectionAuxiliaryModule<TypeTag>> wellAuxMod_;
@@ -362,6 +463,9 @@ protected:
     PhaseUsage phaseUsage_;
     // Misc. data
     bool terminalOutput_;
+    double loadImbalanceThreshold_;
+    double lastLinearizationTime_ = 0.0;
+    bool imbalancedStepRecorded_ = false;
 
     SimulatorReport report_;
     std::unique_ptr<time::StopWatch> solverTimer_;
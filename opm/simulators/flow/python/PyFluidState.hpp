@@ -0,0 +1,91 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PY_FLUID_STATE_HEADER_INCLUDED
+#define OPM_PY_FLUID_STATE_HEADER_INCLUDED
+
+#include <opm/models/utils/propertysystem.hh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm::Pybind
+{
+    /*
+      Contiguous per-cell and per-well copies of the fluid state.
+
+      The simulator keeps the fluid state in the intensive quantities of
+      each cell, so there is no array the Python bindings can view
+      directly. This class keeps one buffer per quantity which is
+      refreshed in place by update(), so views handed out to Python stay
+      valid and see the new values after every refresh.
+    */
+    template <class TypeTag>
+    class PyFluidState {
+        using Simulator = GetPropType<TypeTag, Opm::Properties::Simulator>;
+        using Model = GetPropType<TypeTag, Opm::Properties::Model>;
+        using ElementContext = GetPropType<TypeTag, Opm::Properties::ElementContext>;
+        using FluidSystem = GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+        using IntensiveQuantities = GetPropType<TypeTag, Opm::Properties::IntensiveQuantities>;
+
+    public:
+        static constexpr std::size_t numPhases = FluidSystem::numPhases;
+
+        PyFluidState(Simulator *ebosSimulator)
+            : ebosSimulator_(ebosSimulator) { }
+
+        // Refresh all buffers from the current state of the simulator.
+        void update();
+
+        std::size_t numCells() const { return pressure_.size(); }
+        std::size_t numWells() const { return wellNames_.size(); }
+
+        // Oil phase pressure of each cell.
+        const std::vector<double>& pressure() const { return pressure_; }
+        // Saturations, numPhases x numCells, indexed by the phase indices
+        // of the fluid system. Inactive phases are zero.
+        const std::vector<double>& saturation() const { return saturation_; }
+        const std::vector<double>& rs() const { return rs_; }
+        const std::vector<double>& rv() const { return rv_; }
+
+        // Names of the wells on this process, in the order of wellRates().
+        const std::vector<std::string>& wellNames() const { return wellNames_; }
+        // Surface rates, numWells x numPhases, in the phase order of the
+        // well state. Production rates are negative.
+        const std::vector<double>& wellRates() const { return wellRates_; }
+        std::size_t numWellPhases() const { return numWellPhases_; }
+
+    private:
+        void updateCell_(unsigned cellIdx, const IntensiveQuantities& intQuants);
+        void updateWells_();
+
+        Simulator *ebosSimulator_;
+        std::vector<double> pressure_;
+        std::vector<double> saturation_;
+        std::vector<double> rs_;
+        std::vector<double> rv_;
+        std::vector<std::string> wellNames_;
+        std::vector<double> wellRates_;
+        std::size_t numWellPhases_ = 0;
+    };
+
+}
+#include "PyFluidState_impl.hpp"
+
+#endif // OPM_PY_FLUID_STATE_HEADER_INCLUDED
@@ -0,0 +1,119 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Opm::Pybind {
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+update()
+{
+    const Model &model = ebosSimulator_->model();
+    const std::size_t numCells = model.numGridDof();
+    pressure_.resize(numCells);
+    saturation_.resize(numPhases * numCells);
+    rs_.resize(numCells);
+    rv_.resize(numCells);
+
+    bool cacheMiss = false;
+    for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        const auto* intQuants = model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+        if (!intQuants) {
+            cacheMiss = true;
+            break;
+        }
+        updateCell_(cellIdx, *intQuants);
+    }
+
+    if (cacheMiss) {
+        // Intensive quantities are not cached, compute them.
+        ElementContext elemCtx(*ebosSimulator_);
+        auto elemIt = ebosSimulator_->gridView().template begin</*codim=*/0>();
+        const auto& elemEndIt = ebosSimulator_->gridView().template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            elemCtx.updatePrimaryStencil(*elemIt);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            updateCell_(elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0),
+                        elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0));
+        }
+    }
+
+    updateWells_();
+}
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+updateCell_(unsigned cellIdx, const IntensiveQuantities& intQuants)
+{
+    const auto& fs = intQuants.fluidState();
+    const std::size_t numCells = pressure_.size();
+
+    unsigned pressurePhaseIdx = FluidSystem::oilPhaseIdx;
+    if (!FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+        pressurePhaseIdx = FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+            ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx;
+    }
+    pressure_[cellIdx] = getValue(fs.pressure(pressurePhaseIdx));
+
+    for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+        saturation_[phaseIdx * numCells + cellIdx] =
+            FluidSystem::phaseIsActive(phaseIdx) ? getValue(fs.saturation(phaseIdx)) : 0.0;
+    }
+
+    rs_[cellIdx] = getValue(fs.Rs());
+    rv_[cellIdx] = getValue(fs.Rv());
+}
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+updateWells_()
+{
+    const auto& wellState = ebosSimulator_->problem().wellModel().wellState();
+
+    // One row for every well of the schedule, so that the buffer never
+    // needs to grow when wells are opened later in the run.
+    if (wellNames_.empty()) {
+        wellNames_ = ebosSimulator_->vanguard().schedule().wellNames();
+        numWellPhases_ = wellState.numPhases();
+        wellRates_.resize(wellNames_.size() * numWellPhases_);
+    }
+
+    std::unordered_map<std::string, std::size_t> wellRow;
+    for (std::size_t row = 0; row < wellNames_.size(); ++row) {
+        wellRow.emplace(wellNames_[row], row);
+    }
+
+    std::fill(wellRates_.begin(), wellRates_.end(), 0.0);
+    for (const auto& [name, entry] : wellState.wellMap()) {
+        const auto row = wellRow.find(name);
+        if (row == wellRow.end()) {
+            continue;
+        }
+        const auto& rates = wellState.wellRates(entry[0]);
+        std::copy(rates.begin(), rates.end(),
+                  wellRates_.begin() + row->second * numWellPhases_);
+    }
+}
+
+} //namespace Opm::Pybind
@@ -46,9 +46,12 @@ namespace Opm::Pybind
             : ebosSimulator_(ebosSimulator) { }
 
         std::unique_ptr<double []> getCellVolumes( std::size_t *size);
-        std::unique_ptr<double []> getPorosity( std::size_t *size);
+        const std::vector<double>& getPorosity() const;
+        void setPermeabilityMultipliers(const double *mult, std::size_t size);
         void setPorosity(const double *poro, std::size_t size);
     private:
+        void checkSize_(const std::string& name, std::size_t size) const;
+
         Simulator *ebosSimulator_;
     };
 
@@ -34,18 +34,21 @@ getCellVolumes( std::size_t *size)
 }
 
 template <class TypeTag>
-std::unique_ptr<double []>
+const std::vector<double>&
 PyMaterialState<TypeTag>::
-getPorosity( std::size_t *size)
+getPorosity() const
 {
-    Problem &problem = ebosSimulator_->problem();
-    Model &model = ebosSimulator_->model();
-    *size = model.numGridDof();
-    auto array = std::make_unique<double []>(*size);
-    for (unsigned dofIdx = 0; dofIdx < *size; ++dofIdx) {
-        array[dofIdx] = problem.referencePorosity(dofIdx, /*timeIdx*/0);
-    }
-    return array;
+    return ebosSimulator_->problem().referencePorosities(/*timeIdx*/0);
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+setPermeabilityMultipliers(const double *mult, std::size_t size)
+{
+    checkSize_("permeability multipliers", size);
+    ebosSimulator_->problem().setPermeabilityMultipliers(
+        std::vector<double>(mult, mult + size));
 }
 
 template <class TypeTag>
@@ -53,17 +56,21 @@ void
 PyMaterialState<TypeTag>::
 setPorosity(const double *poro, std::size_t size)
 {
-    Problem &problem = ebosSimulator_->problem();
-    Model &model = ebosSimulator_->model();
-    auto model_size = model.numGridDof();
+    checkSize_("porosity", size);
+    ebosSimulator_->problem().setPorosities(poro);
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+checkSize_(const std::string& name, std::size_t size) const
+{
+    auto model_size = ebosSimulator_->model().numGridDof();
     if (model_size != size) {
         std::ostringstream message;
-        message << "Cannot set porosity. Expected array of size: "
+        message << "Cannot set " << name << ". Expected array of size: "
                 << model_size << ", got array of size: " << size;
         throw std::runtime_error(message.str());
     }
-    for (unsigned dofIdx = 0; dofIdx < size; ++dofIdx) {
-        problem.setPorosity(poro[dofIdx], dofIdx);
-    }
 }
 } //namespace Opm::Pybind
@@ -22,10 +22,18 @@
 
 #include <opm/simulators/flow/Main.hpp>
 #include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/flow/SimulatorCheckpoint.hpp>
+#include <opm/simulators/flow/python/PyFluidState.hpp>
+#include <opm/simulators/flow/python/PyMaterialState.hpp>
+#include <opm/simulators/timestepping/SimulatorTimer.hpp>
 #include <opm/models/utils/propertysystem.hh>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace py = pybind11;
 
 namespace Opm::Pybind {
@@ -37,15 +45,41 @@ private:
 
 public:
     BlackOilSimulator( const std::string &deckFilename);
+    int checkpoint();
+    void discardCheckpoint(int handle);
     py::array_t<double> getPorosity();
+    py::array_t<double> getPressure();
+    py::array_t<double> getRs();
+    py::array_t<double> getRv();
+    py::array_t<double> getSaturation();
+    std::vector<std::string> getWellNames();
+    py::array_t<double> getWellRates();
+    void restore(int handle);
     int run();
+    void setPermeabilityMultipliers(
+         py::array_t<double, py::array::c_style | py::array::forcecast> array);
     void setPorosity(
          py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    void setWellStatus(const std::vector<std::string>& names,
+                       const std::vector<bool>& open);
     int step();
     int stepInit();
     int stepCleanup();
 
 private:
+    // In-memory copy of the simulation state, see checkpoint()
+    struct Checkpoint
+    {
+        SimulatorCheckpoint<TypeTag> state;
+        SimulatorTimer timer;
+        double suggestedNextStep;
+    };
+
+    void checkStepping_(const std::string& method) const;
+    const PyFluidState<TypeTag>& currentFluidState_();
+    py::array_t<double> view_(const std::vector<double>& data,
+                              std::vector<py::ssize_t> shape);
+
     const std::string deckFilename_;
     bool hasRunInit_ = false;
     bool hasRunCleanup_ = false;
@@ -54,6 +88,10 @@ private:
     std::unique_ptr<Opm::Main> main_;
     Simulator *ebosSimulator_;
     std::unique_ptr<PyMaterialState<TypeTag>> materialState_;
+    std::unique_ptr<PyFluidState<TypeTag>> fluidState_;
+
+    std::map<int, Checkpoint> checkpoints_;
+    int nextCheckpoint_ = 0;
 };
 
 } // namespace Opm::Pybind
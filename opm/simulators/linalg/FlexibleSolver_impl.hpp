@@ -24,6 +24,7 @@
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
@@ -31,6 +32,80 @@
 #include <dune/istl/umfpack.hh>
 #include <dune/istl/owneroverlapcopy.hh>
 #include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Opm::detail
+{
+    /// The parallel scalar product of dune-istl, which adds the time of its
+    /// global reductions to the linear solver communication of the
+    /// performance timers. The sums over the rows owned by this process are
+    /// not part of that time.
+    template <class VectorType, class Comm>
+    class TimedParallelScalarProduct : public Dune::ScalarProduct<VectorType>
+    {
+    public:
+        using field_type = typename Dune::ScalarProduct<VectorType>::field_type;
+        using real_type = typename Dune::ScalarProduct<VectorType>::real_type;
+
+        TimedParallelScalarProduct(const Comm& comm, Dune::SolverCategory::Category category)
+            : comm_(comm)
+            , category_(category)
+        {}
+
+        field_type dot(const VectorType& x, const VectorType& y) const override
+        {
+            const auto& mask = ownerMask_(x.size());
+            field_type result = 0.0;
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                result += x[i].dot(y[i]) * mask[i];
+            }
+            ScopedPerformanceTimer timer(PerformanceTimers::LinearSolverCommunication);
+            return comm_.communicator().sum(result);
+        }
+
+        real_type norm(const VectorType& x) const override
+        {
+            const auto& mask = ownerMask_(x.size());
+            real_type result = 0.0;
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                result += x[i].two_norm2() * mask[i];
+            }
+            ScopedPerformanceTimer timer(PerformanceTimers::LinearSolverCommunication);
+            using std::sqrt;
+            return sqrt(comm_.communicator().sum(result));
+        }
+
+        Dune::SolverCategory::Category category() const override
+        {
+            return category_;
+        }
+
+    private:
+        /// 1 for the rows owned by this process, 0 for the others, as in
+        /// OwnerOverlapCopyCommunication.
+        const std::vector<double>& ownerMask_(std::size_t size) const
+        {
+            if (mask_.size() != size) {
+                mask_.assign(size, 1.0);
+                for (const auto& index : comm_.indexSet()) {
+                    if (index.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner) {
+                        mask_[index.local().local()] = 0.0;
+                    }
+                }
+            }
+            return mask_;
+        }
+
+        const Comm& comm_;
+        Dune::SolverCategory::Category category_;
+        mutable std::vector<double> mask_;
+    };
+} // namespace Opm::detail
 
 namespace Dune
 {
@@ -113,7 +188,11 @@ namespace Dune
                                                                                     weightsCalculator,
                                                                                     comm,
                                                                                     pressureIndex);
-        scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, op.category());
+        if (Opm::PerformanceTimers::enabled() && op.category() == Dune::SolverCategory::overlapping) {
+            scalarproduct_ = std::make_shared<Opm::detail::TimedParallelScalarProduct<VectorType, Comm>>(comm, op.category());
+        } else {
+            scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, op.category());
+        }
         linearoperator_for_precond_ = op_prec;
     }
 
@@ -137,6 +137,10 @@ template<class TypeTag, class MyTypeTag>
 struct FpgaBitstream {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct LinearSolverWriteSnapshot {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct LinearSolverReduction<TypeTag, TTag::FlowIstlSolverParams> {
@@ -236,6 +240,10 @@ template<class TypeTag>
 struct FpgaBitstream<TypeTag, TTag::FlowIstlSolverParams> {
     static constexpr auto value = "";
 };
+template<class TypeTag>
+struct LinearSolverWriteSnapshot<TypeTag, TTag::FlowIstlSolverParams> {
+    static constexpr bool value = false;
+};
 
 } // namespace Opm::Properties
 
@@ -267,6 +275,7 @@ namespace Opm
         int cpr_reuse_setup_ = 0;
         std::string opencl_ilu_reorder_;
         std::string fpga_bitstream_;
+        bool write_snapshot_;
 
         template <class TypeTag>
         void init()
@@ -293,6 +302,7 @@ namespace Opm
             opencl_platform_id_ = EWOMS_GET_PARAM(TypeTag, int, OpenclPlatformId);
             opencl_ilu_reorder_ = EWOMS_GET_PARAM(TypeTag, std::string, OpenclIluReorder);
             fpga_bitstream_ = EWOMS_GET_PARAM(TypeTag, std::string, FpgaBitstream);
+            write_snapshot_ = EWOMS_GET_PARAM(TypeTag, bool, LinearSolverWriteSnapshot);
         }
 
         template <class TypeTag>
@@ -319,6 +329,7 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, OpenclPlatformId, "Choose platform ID for openclSolver, use 'clinfo' to determine valid platform IDs");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, OpenclIluReorder, "Choose the reordering strategy for ILU for openclSolver and fpgaSolver, usage: '--opencl-ilu-reorder=[level_scheduling|graph_coloring], level_scheduling behaves like Dune and cusparse, graph_coloring is more aggressive and likely to be faster, but is random-based and generally increases the number of linear solves and linear iterations significantly.");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, FpgaBitstream, "Specify the bitstream file for fpgaSolver (including path), usage: '--fpga-bitstream=<filename>'");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, LinearSolverWriteSnapshot, "Write a binary snapshot of every linear system to the reports/ directory of the output directory, one file per process, which can be replayed with the replaylinearsystem program");
         }
 
         FlowLinearSolverParameters() { reset(); }
@@ -343,6 +354,7 @@ namespace Opm
             opencl_platform_id_       = 0;
             opencl_ilu_reorder_       = "";  // note: the default value is chosen depending on the solver used
             fpga_bitstream_           = "";
+            write_snapshot_           = false;
         }
     };
 
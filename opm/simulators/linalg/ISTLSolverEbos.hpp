@@ -250,6 +250,9 @@ namespace Opm
                                     *rhs_,
                                     comm_.get());
             }
+            if (parameters_.write_snapshot_) {
+                writeSnapshot();
+            }
 
             // Solve system.
             Dune::InverseOperatorResult result;
@@ -474,6 +477,58 @@ namespace Opm
         }
 
 
+        /// Write the system about to be solved, with everything needed to
+        /// solve it again outside of the simulator.
+        void writeSnapshot() const
+        {
+            LinearSystemSnapshotLayout layout;
+            layout.rank = simulator_.gridView().comm().rank();
+            layout.numRanks = simulator_.gridView().comm().size();
+            layout.interiorSize = interiorCellNum_;
+#if HAVE_MPI
+            if (isParallel()) {
+                const std::size_t size = getMatrix().N();
+                layout.globalIndex.assign(size, -1);
+                layout.attribute.assign(size, Dune::OwnerOverlapCopyAttributeSet::copy);
+                layout.isPublic.assign(size, 0);
+                for (const auto& index : comm_->indexSet()) {
+                    const auto local = index.local().local();
+                    layout.globalIndex[local] = index.global();
+                    layout.attribute[local] = index.local().attribute();
+                    layout.isPublic[local] = index.local().isPublic();
+                }
+            }
+#endif
+
+            // Without the well contributions in the matrix, the wells enter
+            // the solver as a separate operator. Assemble that operator into
+            // a matrix of its own so that the replay can apply it.
+            std::optional<SparseMatrixAdapter> wellMatrix;
+            if (!useWellConn_) {
+                const auto& wellModel = simulator_.problem().wellModel();
+                const std::size_t size = getMatrix().N();
+                wellMatrix.emplace(size, size);
+                wellMatrix->reserve(wellModel.wellContributionsPattern(size));
+                wellMatrix->clear();
+                wellModel.addWellContributions(*wellMatrix);
+            }
+
+            std::optional<Vector> weights;
+            if (const auto weightsCalculator = getWeightsCalculator()) {
+                weights = weightsCalculator();
+            }
+
+            Helper::writeSystemSnapshot(simulator_,
+                                        getMatrix(),
+                                        *rhs_,
+                                        wellMatrix ? &wellMatrix->istlMatrix() : nullptr,
+                                        weights ? &*weights : nullptr,
+                                        layout,
+                                        pressureIndex,
+                                        prm_);
+        }
+
+
         /// Zero out off-diagonal blocks on rows corresponding to overlap cells
         /// Diagonal blocks on ovelap rows are set to diag(1.0).
         void makeOverlapRowsInvalid(Matrix& matrix) const
@@ -0,0 +1,395 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LINEARSYSTEMSNAPSHOT_HEADER_INCLUDED
+#define OPM_LINEARSYSTEMSNAPSHOT_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Parallel layout of the rows of one process: the global index,
+    /// the owner/overlap/copy attribute and the public flag of every
+    /// local row, as stored in the index set of the communication
+    /// object. Empty in serial runs.
+    struct LinearSystemSnapshotLayout
+    {
+        int rank = 0;
+        int numRanks = 1;
+        std::size_t interiorSize = 0;
+        std::vector<int> globalIndex;
+        std::vector<int> attribute;
+        std::vector<char> isPublic;
+    };
+
+    /// Header information of a snapshot file, which can be read without
+    /// knowing the block size of the system.
+    struct LinearSystemSnapshotInfo
+    {
+        int blockSize = 0;
+        int rank = 0;
+        int numRanks = 1;
+        int pressureIndex = 0;
+        bool hasWellMatrix = false;
+        bool hasWeights = false;
+    };
+
+    /// A linear system as read back from a snapshot file.
+    template <class Matrix, class Vector>
+    struct LinearSystemSnapshot
+    {
+        LinearSystemSnapshotInfo info;
+        LinearSystemSnapshotLayout layout;
+        Matrix matrix;
+        Vector rhs;
+        /// Schur complement of the well equations, -C^T D^-1 B, if the wells
+        /// were not added to the matrix itself.
+        std::optional<Matrix> wellMatrix;
+        /// CPR weights used when the system was solved.
+        std::optional<Vector> weights;
+        PropertyTree prm;
+    };
+
+namespace Detail
+{
+    // The format is a plain dump in the native byte order of the machine
+    // that wrote the snapshot; it is meant for replaying systems on the
+    // same kind of machine, not for archiving.
+    constexpr std::array<char, 8> snapshotMagic = {'O', 'P', 'M', 'L', 'S', 'Y', 'S', '\0'};
+    constexpr std::uint32_t snapshotVersion = 1;
+
+    enum SnapshotFlags : std::uint32_t
+    {
+        HasWellMatrix = 1,
+        HasWeights = 2,
+        HasLayout = 4
+    };
+
+    template <class T>
+    void writeBinary(std::ostream& os, const T& value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    void writeBinary(std::ostream& os, const std::vector<T>& values)
+    {
+        writeBinary(os, static_cast<std::uint64_t>(values.size()));
+        os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <class T>
+    void readBinary(std::istream& is, T& value)
+    {
+        is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!is) {
+            OPM_THROW(std::runtime_error, "Unexpected end of linear system snapshot");
+        }
+    }
+
+    template <class T>
+    void readBinary(std::istream& is, std::vector<T>& values)
+    {
+        std::uint64_t size = 0;
+        readBinary(is, size);
+        values.resize(size);
+        is.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+        if (!is) {
+            OPM_THROW(std::runtime_error, "Unexpected end of linear system snapshot");
+        }
+    }
+
+    /// Writes the BCRS structure as row offsets and column indices, followed
+    /// by the entries of all blocks in row major order.
+    template <class Matrix>
+    void writeSnapshotMatrix(std::ostream& os, const Matrix& matrix)
+    {
+        constexpr int rows = Matrix::block_type::rows;
+        constexpr int cols = Matrix::block_type::cols;
+
+        std::vector<std::uint64_t> rowOffsets;
+        std::vector<std::uint32_t> columns;
+        rowOffsets.reserve(matrix.N() + 1);
+        columns.reserve(matrix.nonzeroes());
+        rowOffsets.push_back(0);
+        for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                columns.push_back(col.index());
+            }
+            rowOffsets.push_back(columns.size());
+        }
+        writeBinary(os, static_cast<std::uint64_t>(matrix.N()));
+        writeBinary(os, static_cast<std::uint64_t>(matrix.M()));
+        writeBinary(os, rowOffsets);
+        writeBinary(os, columns);
+
+        std::vector<double> values;
+        for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+            values.clear();
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < cols; ++j) {
+                        values.push_back((*col)[i][j]);
+                    }
+                }
+            }
+            os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+        }
+    }
+
+    template <class Matrix>
+    void readSnapshotMatrix(std::istream& is, Matrix& matrix)
+    {
+        constexpr int rows = Matrix::block_type::rows;
+        constexpr int cols = Matrix::block_type::cols;
+
+        std::uint64_t numRows = 0;
+        std::uint64_t numCols = 0;
+        std::vector<std::uint64_t> rowOffsets;
+        std::vector<std::uint32_t> columns;
+        readBinary(is, numRows);
+        readBinary(is, numCols);
+        readBinary(is, rowOffsets);
+        readBinary(is, columns);
+        if (rowOffsets.size() != numRows + 1 || rowOffsets.back() != columns.size()) {
+            OPM_THROW(std::runtime_error, "Inconsistent matrix structure in linear system snapshot");
+        }
+
+        matrix = Matrix();
+        matrix.setBuildMode(Matrix::row_wise);
+        matrix.setSize(numRows, numCols, columns.size());
+        for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+            for (auto k = rowOffsets[row.index()]; k < rowOffsets[row.index() + 1]; ++k) {
+                row.insert(columns[k]);
+            }
+        }
+
+        std::vector<double> values(columns.size() * rows * cols);
+        is.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double));
+        if (!is) {
+            OPM_THROW(std::runtime_error, "Unexpected end of linear system snapshot");
+        }
+        auto value = values.begin();
+        for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < cols; ++j) {
+                        (*col)[i][j] = *value++;
+                    }
+                }
+            }
+        }
+    }
+
+    template <class Vector>
+    void writeSnapshotVector(std::ostream& os, const Vector& vector)
+    {
+        constexpr int size = Vector::block_type::dimension;
+        std::vector<double> values;
+        values.reserve(vector.size() * size);
+        for (const auto& block : vector) {
+            for (int i = 0; i < size; ++i) {
+                values.push_back(block[i]);
+            }
+        }
+        writeBinary(os, values);
+    }
+
+    template <class Vector>
+    void readSnapshotVector(std::istream& is, Vector& vector)
+    {
+        constexpr int size = Vector::block_type::dimension;
+        std::vector<double> values;
+        readBinary(is, values);
+        if (values.size() % size != 0) {
+            OPM_THROW(std::runtime_error, "Inconsistent vector size in linear system snapshot");
+        }
+        vector.resize(values.size() / size);
+        auto value = values.begin();
+        for (auto& block : vector) {
+            for (int i = 0; i < size; ++i) {
+                block[i] = *value++;
+            }
+        }
+    }
+
+    inline LinearSystemSnapshotInfo readSnapshotHeader(std::istream& is, std::uint32_t& flags)
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version = 0;
+        is.read(magic.data(), magic.size());
+        readBinary(is, version);
+        if (magic != snapshotMagic || version != snapshotVersion) {
+            OPM_THROW(std::runtime_error, "Not a linear system snapshot, or unsupported version");
+        }
+
+        LinearSystemSnapshotInfo info;
+        std::int32_t value = 0;
+        readBinary(is, value); info.blockSize = value;
+        readBinary(is, value); info.rank = value;
+        readBinary(is, value); info.numRanks = value;
+        readBinary(is, value); info.pressureIndex = value;
+        readBinary(is, flags);
+        info.hasWellMatrix = (flags & HasWellMatrix) != 0;
+        info.hasWeights = (flags & HasWeights) != 0;
+        return info;
+    }
+
+    inline std::ifstream openSnapshot(const std::string& filename)
+    {
+        std::ifstream is(filename, std::ios::binary);
+        if (!is) {
+            OPM_THROW(std::runtime_error, "Could not open linear system snapshot " << filename);
+        }
+        return is;
+    }
+} // namespace Detail
+
+    /// Write the linear system of one process to a binary file: the matrix
+    /// with its block structure, the right hand side, optionally the Schur
+    /// complement of the wells and the CPR weights, the parallel layout of
+    /// the rows and the settings of the linear solver.
+    template <class Matrix, class Vector>
+    void writeLinearSystemSnapshot(const std::string& filename,
+                                   const Matrix& matrix,
+                                   const Vector& rhs,
+                                   const Matrix* wellMatrix,
+                                   const Vector* weights,
+                                   const LinearSystemSnapshotLayout& layout,
+                                   const int pressureIndex,
+                                   const PropertyTree& prm)
+    {
+        static_assert(Matrix::block_type::rows == Matrix::block_type::cols,
+                      "Only square blocks are supported in linear system snapshots");
+
+        std::ofstream os(filename, std::ios::binary);
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Could not create linear system snapshot " << filename);
+        }
+
+        std::uint32_t flags = 0;
+        if (wellMatrix != nullptr)
+            flags |= Detail::HasWellMatrix;
+        if (weights != nullptr)
+            flags |= Detail::HasWeights;
+        if (!layout.globalIndex.empty())
+            flags |= Detail::HasLayout;
+
+        os.write(Detail::snapshotMagic.data(), Detail::snapshotMagic.size());
+        Detail::writeBinary(os, Detail::snapshotVersion);
+        Detail::writeBinary(os, static_cast<std::int32_t>(Matrix::block_type::rows));
+        Detail::writeBinary(os, static_cast<std::int32_t>(layout.rank));
+        Detail::writeBinary(os, static_cast<std::int32_t>(layout.numRanks));
+        Detail::writeBinary(os, static_cast<std::int32_t>(pressureIndex));
+        Detail::writeBinary(os, flags);
+
+        std::ostringstream settings;
+        prm.write_json(settings, false);
+        const auto json = settings.str();
+        Detail::writeBinary(os, std::vector<char>(json.begin(), json.end()));
+
+        Detail::writeSnapshotMatrix(os, matrix);
+        Detail::writeSnapshotVector(os, rhs);
+        if (wellMatrix != nullptr)
+            Detail::writeSnapshotMatrix(os, *wellMatrix);
+        if (weights != nullptr)
+            Detail::writeSnapshotVector(os, *weights);
+
+        Detail::writeBinary(os, static_cast<std::uint64_t>(layout.interiorSize));
+        if (flags & Detail::HasLayout) {
+            Detail::writeBinary(os, layout.globalIndex);
+            Detail::writeBinary(os, layout.attribute);
+            Detail::writeBinary(os, layout.isPublic);
+        }
+
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Could not write linear system snapshot " << filename);
+        }
+    }
+
+    /// Read the header of a snapshot file, to find the block size before
+    /// reading the system itself.
+    inline LinearSystemSnapshotInfo readLinearSystemSnapshotInfo(const std::string& filename)
+    {
+        auto is = Detail::openSnapshot(filename);
+        std::uint32_t flags = 0;
+        return Detail::readSnapshotHeader(is, flags);
+    }
+
+    /// Read a linear system written by writeLinearSystemSnapshot(). The
+    /// block size of Matrix and Vector must match the one of the file.
+    template <class Matrix, class Vector>
+    LinearSystemSnapshot<Matrix, Vector> readLinearSystemSnapshot(const std::string& filename)
+    {
+        auto is = Detail::openSnapshot(filename);
+
+        LinearSystemSnapshot<Matrix, Vector> snapshot;
+        std::uint32_t flags = 0;
+        snapshot.info = Detail::readSnapshotHeader(is, flags);
+        if (snapshot.info.blockSize != Matrix::block_type::rows) {
+            OPM_THROW(std::runtime_error, "Linear system snapshot " << filename << " has block size "
+                      << snapshot.info.blockSize << ", expected " << Matrix::block_type::rows);
+        }
+        snapshot.layout.rank = snapshot.info.rank;
+        snapshot.layout.numRanks = snapshot.info.numRanks;
+
+        std::vector<char> json;
+        Detail::readBinary(is, json);
+        std::istringstream settings(std::string(json.begin(), json.end()));
+        snapshot.prm.read_json(settings);
+
+        Detail::readSnapshotMatrix(is, snapshot.matrix);
+        Detail::readSnapshotVector(is, snapshot.rhs);
+        if (flags & Detail::HasWellMatrix) {
+            snapshot.wellMatrix.emplace();
+            Detail::readSnapshotMatrix(is, *snapshot.wellMatrix);
+        }
+        if (flags & Detail::HasWeights) {
+            snapshot.weights.emplace();
+            Detail::readSnapshotVector(is, *snapshot.weights);
+        }
+
+        std::uint64_t interiorSize = 0;
+        Detail::readBinary(is, interiorSize);
+        snapshot.layout.interiorSize = interiorSize;
+        if (flags & Detail::HasLayout) {
+            Detail::readBinary(is, snapshot.layout.globalIndex);
+            Detail::readBinary(is, snapshot.layout.attribute);
+            Detail::readBinary(is, snapshot.layout.isPublic);
+        }
+
+        return snapshot;
+    }
+
+} // namespace Opm
+
+#endif // OPM_LINEARSYSTEMSNAPSHOT_HEADER_INCLUDED
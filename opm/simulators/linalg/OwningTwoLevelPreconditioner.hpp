@@ -32,9 +32,15 @@
 #include <dune/istl/bcrsmatrix.hh>
 #include <dune/istl/paamg/amg.hh>
 
+#include <exception>
 #include <fstream>
+#include <memory>
 #include <type_traits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace Opm
 {
@@ -201,9 +207,50 @@ private:
     void updateImpl(const Dune::Amg::SequentialInformation*)
     {
         // Serial case.
+        // The fine level smoother and the coarse level (the Galerkin product
+        // and the setup of the pressure solver) only read the fine level
+        // matrix, so they are set up concurrently if there is more than one
+        // thread. In the parallel case both of them communicate, which is
+        // why it is not done there.
         auto child = prm_.get_child_optional("finesmoother");
-        finesmoother_ = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree());
-        twolevel_method_.updatePreconditioner(finesmoother_, coarseSolverPolicy_);
+        std::shared_ptr<Dune::Preconditioner<VectorType, VectorType>> finesmoother;
+        std::exception_ptr fineFailure;
+        std::exception_ptr coarseFailure;
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2) if(omp_get_max_threads() > 1)
+#endif
+        {
+#ifdef _OPENMP
+#pragma omp section
+#endif
+            {
+                try {
+                    finesmoother = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree());
+                }
+                catch (...) {
+                    fineFailure = std::current_exception();
+                }
+            }
+#ifdef _OPENMP
+#pragma omp section
+#endif
+            {
+                try {
+                    twolevel_method_.updateCoarseLevel(coarseSolverPolicy_);
+                }
+                catch (...) {
+                    coarseFailure = std::current_exception();
+                }
+            }
+        }
+        if (fineFailure) {
+            std::rethrow_exception(fineFailure);
+        }
+        if (coarseFailure) {
+            std::rethrow_exception(coarseFailure);
+        }
+        finesmoother_ = finesmoother;
+        twolevel_method_.setSmoother(finesmoother_);
     }
 
     const OperatorType& linear_operator_;
@@ -22,6 +22,7 @@
 
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 #include <opm/common/ErrorMacros.hpp>
 #include <dune/common/version.hh>
 #include <dune/istl/preconditioner.hh>
@@ -906,6 +907,7 @@ public:
     void copyOwnerToAll( V& v ) const
     {
         if( comm_ ) {
+            ScopedPerformanceTimer timer(PerformanceTimers::LinearSolverCommunication);
             comm_->copyOwnerToAll(v, v);
         }
     }
@@ -24,6 +24,7 @@
 #include <dune/istl/preconditioner.hh>
 #include <dune/istl/paamg/smoother.hh>
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 
 namespace Opm
 {
@@ -198,9 +199,15 @@ public:
     {
         // hack us a mutable d to prevent copying.
         Range& md = const_cast<Range&>(d);
-        communication_.copyOwnerToAll(md,md);
+        {
+            Opm::ScopedPerformanceTimer timer(Opm::PerformanceTimers::LinearSolverCommunication);
+            communication_.copyOwnerToAll(md,md);
+        }
         preconditioner_.template apply<forward>(v,d);
-        communication_.copyOwnerToAll(v,v);
+        {
+            Opm::ScopedPerformanceTimer timer(Opm::PerformanceTimers::LinearSolverCommunication);
+            communication_.copyOwnerToAll(v,v);
+        }
         // Make sure that d is the same as at the beginning of apply.
         communication_.project(md);
     }
@@ -72,6 +72,12 @@ void PropertyTree::write_json(std::ostream &os, bool pretty) const
     boost::property_tree::write_json(os, *tree_, pretty);
 }
 
+void PropertyTree::read_json(std::istream &is)
+{
+    tree_->clear();
+    boost::property_tree::read_json(is, *tree_);
+}
+
 PropertyTree
 PropertyTree::get_child(const std::string& key) const
 {
@@ -58,6 +58,8 @@ public:
 
     void write_json(std::ostream& os, bool pretty) const;
 
+    void read_json(std::istream& is);
+
 protected:
     PropertyTree(const boost::property_tree::ptree& tree);
 
@@ -21,18 +21,20 @@
 #define OPM_WRITESYSTEMMATRIXHELPER_HEADER_INCLUDED
 
 #include <dune/istl/matrixmarket.hh>
+#include <opm/simulators/linalg/LinearSystemSnapshot.hpp>
 #include <opm/simulators/linalg/MatrixMarketSpecializations.hpp>
 
+#include <string>
+
 
 namespace Opm
 {
 namespace Helper
 {
-    template <class SimulatorType, class MatrixType, class VectorType, class Communicator>
-    void writeSystem(const SimulatorType& simulator,
-                     const MatrixType& matrix,
-                     const VectorType& rhs,
-                     [[maybe_unused]] const Communicator* comm)
+    /// Common prefix of the files with the linear system of the current
+    /// Newton iteration, in the reports/ directory of the output directory.
+    template <class SimulatorType>
+    std::string systemFilePrefix(const SimulatorType& simulator)
     {
         std::string dir = simulator.problem().outputDir();
         if (dir == ".") {
@@ -55,7 +57,16 @@ namespace Helper
         oss << "_nit_" << nit << "_";
         std::string output_file(oss.str());
         fs::path full_path = output_dir / output_file;
-        std::string prefix = full_path.string();
+        return full_path.string();
+    }
+
+    template <class SimulatorType, class MatrixType, class VectorType, class Communicator>
+    void writeSystem(const SimulatorType& simulator,
+                     const MatrixType& matrix,
+                     const VectorType& rhs,
+                     [[maybe_unused]] const Communicator* comm)
+    {
+        const std::string prefix = systemFilePrefix(simulator);
         {
             std::string filename = prefix + "matrix_istl";
 #if HAVE_MPI
@@ -81,6 +92,26 @@ namespace Helper
     }
 
 
+    /// Write the linear system of this process as a binary snapshot, see
+    /// writeLinearSystemSnapshot(). The snapshot of process r is written to
+    /// <prefix>system_<r>.osys, where the prefix is the same as for
+    /// writeSystem().
+    template <class SimulatorType, class MatrixType, class VectorType>
+    void writeSystemSnapshot(const SimulatorType& simulator,
+                             const MatrixType& matrix,
+                             const VectorType& rhs,
+                             const MatrixType* wellMatrix,
+                             const VectorType* weights,
+                             const LinearSystemSnapshotLayout& layout,
+                             const int pressureIndex,
+                             const PropertyTree& prm)
+    {
+        const std::string filename = systemFilePrefix(simulator)
+            + "system_" + std::to_string(layout.rank) + ".osys";
+        writeLinearSystemSnapshot(filename, matrix, rhs, wellMatrix, weights,
+                                  layout, pressureIndex, prm);
+    }
+
 } // namespace Helper
 } // namespace Opm
 #endif
@@ -451,7 +451,25 @@ public:
                             CoarseLevelSolverPolicy& coarsePolicy)
   {
     //assume new matrix is not reallocated the new precondition should anyway be made
+    setSmoother(smoother);
+    updateCoarseLevel(coarsePolicy);
+  }
+
+  /**
+   * @brief Replace the fine level smoother.
+   */
+  void setSmoother(std::shared_ptr<SmootherType> smoother)
+  {
     smoother_ = smoother;
+  }
+
+  /**
+   * @brief Update the coarse level system and its solver for a changed fine level matrix.
+   *
+   * Does not touch the fine level smoother, so the two may be updated concurrently.
+   */
+  void updateCoarseLevel(CoarseLevelSolverPolicy& coarsePolicy)
+  {
     if (coarseSolver_) {
       policy_->calculateCoarseEntries(*operator_);
       coarsePolicy.setCoarseOperator(*policy_);
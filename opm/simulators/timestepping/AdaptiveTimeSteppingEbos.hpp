@@ -112,6 +112,10 @@ template<class TypeTag, class MyTypeTag>
 struct MinTimeStepBasedOnNewtonIterations {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct TimeStepControlFailedStepTarget {
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct SolverRestartFactor<TypeTag, TTag::FlowTimeSteppingParameters> {
@@ -216,6 +220,11 @@ struct MinTimeStepBasedOnNewtonIterations<TypeTag, TTag::FlowTimeSteppingParamet
     using type = GetPropType<TypeTag, Scalar>;
     static constexpr type value = 0.0;
 };
+template<class TypeTag>
+struct TimeStepControlFailedStepTarget<TypeTag, TTag::FlowTimeSteppingParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
 
 } // namespace Opm::Properties
 
@@ -348,6 +357,8 @@ namespace Opm {
                                  "The minimum time step size in days for which problematic wells are not shut");
             EWOMS_REGISTER_PARAM(TypeTag, double, MinTimeStepBasedOnNewtonIterations,
                                  "The minimum time step size (in days for field and metric unit and hours for lab unit) can be reduced to based on newton iteration counts");
+            EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepControlFailedStepTarget,
+                                 "Limit the time steps after a failed step to this fraction of the failed step size, growing by the growth rate with every converged step (0 to disable)");
         }
 
         /** \brief  step method that acts like the solver::step method
@@ -456,6 +467,7 @@ namespace Opm {
                         : substepReport.total_linear_iterations;
                     double dtEstimate = timeStepControl_->computeTimeStepSize(dt, iterations, relativeChange,
                                                                                substepTimer.simulationTimeElapsed());
+                    timeStepControl_->registerConvergedStep(dt, dtEstimate);
 
                     assert(dtEstimate > 0);
                     // limit the growth of the timestep size by the growth factor
@@ -520,6 +532,7 @@ namespace Opm {
 
                     // The new, chopped timestep.
                     const double newTimeStep = restartFactor_ * dt;
+                    timeStepControl_->registerFailedStep(dt);
 
 
                     // If we have restarted (i.e. cut the timestep) too
@@ -671,6 +684,13 @@ namespace Opm {
             else
                 OPM_THROW(std::runtime_error,"Unsupported time step control selected "<< control);
 
+            const double failedStepTarget = EWOMS_GET_PARAM(TypeTag, double, TimeStepControlFailedStepTarget); // 0.0
+            if (failedStepTarget > 0.0) {
+                const double growthrate = EWOMS_GET_PARAM(TypeTag, double, TimeStepControlGrowthRate); // 1.25
+                timeStepControl_ = TimeStepControlType(new FailedStepLimitedTimeStepControl(std::move(timeStepControl_),
+                                                                                            failedStepTarget, growthrate));
+            }
+
             // make sure growth factor is something reasonable
             assert(growthFactor_ >= 1.0);
         }
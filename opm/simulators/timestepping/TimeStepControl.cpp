@@ -23,6 +23,7 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <fstream>
@@ -207,4 +208,56 @@ namespace Opm
         return std::min(dtEstimatePID, dtEstimateIter);
     }
 
+
+
+    ////////////////////////////////////////////////////////
+    //
+    //  FailedStepLimitedTimeStepControl Implementation
+    //
+    ////////////////////////////////////////////////////////
+
+    FailedStepLimitedTimeStepControl::
+    FailedStepLimitedTimeStepControl( std::unique_ptr<TimeStepControlInterface> control,
+                                      const double targetFactor,
+                                      const double targetGrowth )
+        : control_( std::move(control) )
+        , targetFactor_( targetFactor )
+        , targetGrowth_( targetGrowth )
+        , target_( std::numeric_limits<double>::infinity() )
+    {
+        if( targetFactor_ <= 0.0 || targetFactor_ > 1.0 ) {
+            OPM_THROW(std::runtime_error,"FailedStepLimitedTimeStepControl: target factor should be in (0, 1] " << targetFactor_ );
+        }
+        if( targetGrowth_ < 1.0 ) {
+            OPM_THROW(std::runtime_error,"FailedStepLimitedTimeStepControl: growth should be >= 1 " << targetGrowth_ );
+        }
+    }
+
+    double FailedStepLimitedTimeStepControl::
+    computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange, const double simulationTimeElapsed ) const
+    {
+        const double dtEstimate = control_->computeTimeStepSize( dt, iterations, relativeChange, simulationTimeElapsed );
+
+        // the step converged, so the limit is relaxed
+        return std::min( dtEstimate, target_ * targetGrowth_ );
+    }
+
+    void FailedStepLimitedTimeStepControl::
+    registerConvergedStep( const double dt, const double dtEstimate )
+    {
+        control_->registerConvergedStep( dt, dtEstimate );
+        target_ *= targetGrowth_;
+        if( dtEstimate < target_ ) {
+            // the limit no longer restricts the step, forget about it
+            target_ = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    void FailedStepLimitedTimeStepControl::
+    registerFailedStep( const double dt )
+    {
+        control_->registerFailedStep( dt );
+        target_ = std::min( target_, targetFactor_ * dt );
+    }
+
 } // end namespace Opm
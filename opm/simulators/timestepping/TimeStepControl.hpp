@@ -21,6 +21,7 @@
 #ifndef OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 
+#include <memory>
 #include <vector>
 
 #include <opm/simulators/timestepping/TimeStepControlInterface.hpp>
@@ -145,6 +146,45 @@ namespace Opm
         std::vector<double> subStepTime_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ///
+    ///  Adaptive time step control that limits the suggestions of another control
+    ///  by what was learned from failed steps. After a step of size dt failed, the
+    ///  limit is set to targetFactor * dt. It grows by targetGrowth with every
+    ///  converged step before it is applied, so the first suggestion after the
+    ///  failure is limited to targetFactor * targetGrowth * dt. The limit is
+    ///  dropped once the other control suggests less. Without the limit, the
+    ///  controls tend to grow the time step straight back to the size that just
+    ///  failed.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class FailedStepLimitedTimeStepControl : public TimeStepControlInterface
+    {
+    public:
+        /// \brief constructor
+        /// \param control       the time step control whose suggestions are limited
+        /// \param targetFactor  fraction of a failed step size the following steps are limited to
+        /// \param targetGrowth  growth of the limit with every converged step (should be >= 1)
+        FailedStepLimitedTimeStepControl( std::unique_ptr<TimeStepControlInterface> control,
+                                          const double targetFactor,
+                                          const double targetGrowth );
+
+        /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
+        double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange, const double simulationTimeElapsed ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::registerFailedStep
+        void registerFailedStep( const double dt );
+
+        /// \brief \copydoc TimeStepControlInterface::registerConvergedStep
+        void registerConvergedStep( const double dt, const double dtEstimate );
+
+    protected:
+        std::unique_ptr<TimeStepControlInterface> control_;
+        const double targetFactor_;
+        const double targetGrowth_;
+        // limit of the time step size before the last converged step, infinite if there is none
+        double target_;
+    };
 
 } // end namespace Opm
 #endif
@@ -58,6 +58,16 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// inform the control that a step of size dt failed and will be chopped
+        /// \param dt  time step size of the failed step
+        virtual void registerFailedStep( const double /* dt */ ) {}
+
+        /// inform the control that a step of size dt converged, after computeTimeStepSize
+        /// suggested dtEstimate for the next step
+        /// \param dt          time step size of the converged step
+        /// \param dtEstimate  the suggestion of computeTimeStepSize for this step
+        virtual void registerConvergedStep( const double /* dt */, const double /* dtEstimate */ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
@@ -0,0 +1,475 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/CellCostPartitioning.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Aquifer/Aquancon.hpp>
+#include <opm/parser/eclipse/EclipseState/Aquifer/AquiferCT.hpp>
+#include <opm/parser/eclipse/EclipseState/Aquifer/Aquifetp.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+constexpr int numCoefficients = 5;
+using CoefficientVector = Dune::FieldVector<double, numCoefficients>;
+using CoefficientMatrix = Dune::FieldMatrix<double, numCoefficients, numCoefficients>;
+
+std::unordered_map<int, int> cartesianToCell(const std::vector<int>& cartesianIndex)
+{
+    std::unordered_map<int, int> map;
+    map.reserve(cartesianIndex.size());
+    for (std::size_t cell = 0; cell < cartesianIndex.size(); ++cell) {
+        map.emplace(cartesianIndex[cell], static_cast<int>(cell));
+    }
+    return map;
+}
+
+int findCell(const std::unordered_map<int, int>& map, const std::size_t cartesianIndex)
+{
+    const auto it = map.find(static_cast<int>(cartesianIndex));
+    return it == map.end() ? -1 : it->second;
+}
+
+CoefficientVector toVector(const Opm::CellCostCoefficients& c)
+{
+    return {c.cell, c.connection, c.perforation, c.msPerforation, c.aquiferConnection};
+}
+
+CoefficientVector toVector(const Opm::CellCostStatistics& s)
+{
+    return {s.cells, s.connections, s.perforations, s.msPerforations, s.aquiferConnections};
+}
+
+// A set of cells which is moved as a whole by the bisection.
+struct Item
+{
+    std::array<double, 3> centroid{};
+    double cost = 0.0;
+};
+
+class UnionFind
+{
+public:
+    explicit UnionFind(const std::size_t n)
+        : parent_(n)
+    {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    int find(int i)
+    {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    void merge(const int a, const int b)
+    {
+        parent_[find(a)] = find(b);
+    }
+
+private:
+    std::vector<int> parent_;
+};
+
+void bisect(const std::vector<Item>& items,
+            std::vector<int>::iterator begin,
+            std::vector<int>::iterator end,
+            const int firstPart,
+            const int numParts,
+            std::vector<int>& itemPart)
+{
+    if (numParts == 1 || end - begin < 2) {
+        for (auto it = begin; it != end; ++it) {
+            itemPart[*it] = firstPart;
+        }
+        return;
+    }
+
+    std::array<double, 3> lower, upper;
+    lower.fill(std::numeric_limits<double>::max());
+    upper.fill(std::numeric_limits<double>::lowest());
+    double totalCost = 0.0;
+    for (auto it = begin; it != end; ++it) {
+        for (int d = 0; d < 3; ++d) {
+            lower[d] = std::min(lower[d], items[*it].centroid[d]);
+            upper[d] = std::max(upper[d], items[*it].centroid[d]);
+        }
+        totalCost += items[*it].cost;
+    }
+    int dir = 0;
+    for (int d = 1; d < 3; ++d) {
+        if (upper[d] - lower[d] > upper[dir] - lower[dir]) {
+            dir = d;
+        }
+    }
+    std::sort(begin, end, [&items, dir](const int a, const int b)
+                          { return items[a].centroid[dir] < items[b].centroid[dir]; });
+
+    const int leftParts = numParts / 2;
+    const double target = totalCost * leftParts / numParts;
+    auto split = begin;
+    double leftCost = 0.0;
+    while (split != end && leftCost + items[*split].cost <= target) {
+        leftCost += items[*split].cost;
+        ++split;
+    }
+    // Take the item that straddles the target if that is closer to it.
+    if (split != end && (leftCost + items[*split].cost - target) < (target - leftCost)) {
+        ++split;
+    }
+    // Both halves must get at least one item per part.
+    split = std::clamp(split, begin + leftParts, end - (numParts - leftParts));
+
+    bisect(items, begin, split, firstPart, leftParts, itemPart);
+    bisect(items, split, end, firstPart + leftParts, numParts - leftParts, itemPart);
+}
+
+// The cells perforated by a well at any report step of the schedule.
+struct WellPerforations
+{
+    std::vector<int> cells;
+    bool multisegment = false;
+};
+
+std::vector<WellPerforations> wellPerforations(const std::unordered_map<int, int>& cellOf,
+                                               const Opm::Schedule& schedule)
+{
+    std::unordered_map<std::string, std::size_t> wellIndex;
+    std::vector<WellPerforations> wells;
+    for (std::size_t step = 0; step < schedule.size(); ++step) {
+        for (const auto& name : schedule.wellNames(step)) {
+            const auto [pos, inserted] = wellIndex.emplace(name, wells.size());
+            if (inserted) {
+                wells.emplace_back();
+            }
+            auto& perforations = wells[pos->second];
+            const auto& well = schedule.getWell(name, step);
+            perforations.multisegment = perforations.multisegment || well.isMultiSegment();
+            for (const auto& connection : well.getConnections()) {
+                const int cell = findCell(cellOf, connection.global_index());
+                if (cell >= 0) {
+                    perforations.cells.push_back(cell);
+                }
+            }
+        }
+    }
+    for (auto& perforations : wells) {
+        auto& cells = perforations.cells;
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    }
+    return wells;
+}
+
+} // Anonymous namespace
+
+namespace Opm {
+
+std::vector<CellCostFeatures> cellCostFeatures(const std::vector<int>& cartesianIndex,
+                                               const std::vector<int>& numNeighbours,
+                                               const EclipseState& eclState,
+                                               const Schedule& schedule)
+{
+    std::vector<CellCostFeatures> features(cartesianIndex.size());
+    for (std::size_t cell = 0; cell < features.size(); ++cell) {
+        features[cell].connections = numNeighbours[cell];
+    }
+    const auto cellOf = cartesianToCell(cartesianIndex);
+
+    // Non-neighbouring connections, including those of numerical aquifers,
+    // are not part of the grid's intersections.
+    for (const auto& nnc : eclState.getInputNNC().input()) {
+        const int cell1 = findCell(cellOf, nnc.cell1);
+        const int cell2 = findCell(cellOf, nnc.cell2);
+        if (cell1 >= 0 && cell2 >= 0) {
+            ++features[cell1].connections;
+            ++features[cell2].connections;
+        }
+    }
+
+    // Wells are counted with all cells they perforate during the run, as
+    // the partitioning is kept for the whole run.
+    for (const auto& well : wellPerforations(cellOf, schedule)) {
+        for (const int cell : well.cells) {
+            ++features[cell].perforations;
+            if (well.multisegment) {
+                ++features[cell].msPerforations;
+            }
+        }
+    }
+
+    const auto& aquifer = eclState.aquifer();
+    if (aquifer.active()) {
+        const auto& connections = aquifer.connections();
+        auto addConnections = [&](const int aquiferID)
+        {
+            for (const auto& connection : connections[aquiferID]) {
+                const int cell = findCell(cellOf, connection.global_index);
+                if (cell >= 0) {
+                    ++features[cell].aquiferConnections;
+                }
+            }
+        };
+        for (const auto& aq : aquifer.ct()) {
+            addConnections(aq.aquiferID);
+        }
+        for (const auto& aq : aquifer.fetp()) {
+            addConnections(aq.aquiferID);
+        }
+    }
+    return features;
+}
+
+std::vector<double> cellCosts(const std::vector<CellCostFeatures>& features,
+                              const CellCostCoefficients& coefficients)
+{
+    std::vector<double> costs(features.size());
+    std::transform(features.begin(), features.end(), costs.begin(),
+                   [&coefficients](const CellCostFeatures& f)
+                   {
+                       return coefficients.cell
+                           + coefficients.connection * f.connections
+                           + coefficients.perforation * f.perforations
+                           + coefficients.msPerforation * f.msPerforations
+                           + coefficients.aquiferConnection * f.aquiferConnections;
+                   });
+    return costs;
+}
+
+std::vector<std::vector<int>> wellCells(const std::vector<int>& cartesianIndex,
+                                        const Schedule& schedule)
+{
+    const auto cellOf = cartesianToCell(cartesianIndex);
+    std::vector<std::vector<int>> cells;
+    for (auto& well : wellPerforations(cellOf, schedule)) {
+        if (well.cells.size() > 1) {
+            cells.push_back(std::move(well.cells));
+        }
+    }
+    return cells;
+}
+
+std::vector<int> partitionCellsByCost(const std::vector<std::array<double, 3>>& centroids,
+                                      const std::vector<double>& costs,
+                                      const std::vector<std::vector<int>>& keepTogether,
+                                      const int numParts)
+{
+    const std::size_t numCells = centroids.size();
+    if (numParts <= 1) {
+        return std::vector<int>(numCells, 0);
+    }
+
+    std::vector<int> cellItem(numCells, -1);
+    std::vector<Item> items;
+    auto makeItems = [&](const std::vector<std::vector<int>>& groups)
+    {
+        UnionFind sets(numCells);
+        for (const auto& group : groups) {
+            for (std::size_t i = 1; i < group.size(); ++i) {
+                sets.merge(group[i], group[0]);
+            }
+        }
+
+        // Items are placed at the cost weighted centroid of their cells.
+        std::vector<int> rootItem(numCells, -1);
+        items.clear();
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            const int root = sets.find(static_cast<int>(cell));
+            if (rootItem[root] < 0) {
+                rootItem[root] = static_cast<int>(items.size());
+                items.emplace_back();
+            }
+            const int item = rootItem[root];
+            cellItem[cell] = item;
+            auto& it = items[item];
+            const double weight = std::max(costs[cell], std::numeric_limits<double>::min());
+            for (int d = 0; d < 3; ++d) {
+                it.centroid[d] += weight * centroids[cell][d];
+            }
+            it.cost += weight;
+        }
+        for (auto& item : items) {
+            for (int d = 0; d < 3; ++d) {
+                item.centroid[d] /= item.cost;
+            }
+        }
+    };
+
+    // Every part needs an item, so the sets are split up if they are
+    // fewer than the parts. Parts remain empty only if there are fewer
+    // cells than parts.
+    makeItems(keepTogether);
+    if (items.size() < static_cast<std::size_t>(numParts)) {
+        makeItems({});
+    }
+    const int usedParts = std::min(numParts, static_cast<int>(items.size()));
+
+    std::vector<int> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<int> itemPart(items.size(), 0);
+    bisect(items, order.begin(), order.end(), 0, usedParts, itemPart);
+
+    std::vector<int> parts(numCells);
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        parts[cell] = itemPart[cellItem[cell]];
+    }
+    return parts;
+}
+
+CellCostStatistics cellCostStatistics(const std::vector<CellCostFeatures>& features,
+                                      const std::vector<bool>& interior,
+                                      const double seconds)
+{
+    CellCostStatistics statistics;
+    for (std::size_t cell = 0; cell < features.size(); ++cell) {
+        if (!interior[cell]) {
+            continue;
+        }
+        statistics.cells += 1.0;
+        statistics.connections += features[cell].connections;
+        statistics.perforations += features[cell].perforations;
+        statistics.msPerforations += features[cell].msPerforations;
+        statistics.aquiferConnections += features[cell].aquiferConnections;
+    }
+    statistics.seconds = seconds;
+    return statistics;
+}
+
+CellCostCoefficients calibrateCellCosts(const std::vector<CellCostStatistics>& statistics,
+                                        const CellCostCoefficients& prior)
+{
+    const auto p = toVector(prior);
+    double totalTime = 0.0;
+    double totalPriorCost = 0.0;
+    for (const auto& s : statistics) {
+        totalTime += s.seconds;
+        totalPriorCost += toVector(s) * p;
+    }
+    if (statistics.empty() || !(totalTime > 0.0) || !(totalPriorCost > 0.0)) {
+        return prior;
+    }
+
+    // Seconds per unit of prior cost, to compare the fit with the prior.
+    const double scale = totalTime / totalPriorCost;
+
+    // Normal equations of the least squares fit of the times, with a
+    // penalty on the deviation from the scaled prior, which is weighted
+    // by the size of each feature so that it does not depend on units.
+    const double regularization = 0.01;
+    CoefficientMatrix A(0.0);
+    CoefficientVector b(0.0);
+    CoefficientVector size(0.0);
+    for (const auto& s : statistics) {
+        const auto x = toVector(s);
+        for (int i = 0; i < numCoefficients; ++i) {
+            for (int j = 0; j < numCoefficients; ++j) {
+                A[i][j] += x[i] * x[j];
+            }
+            b[i] += x[i] * s.seconds;
+            size[i] += x[i] * x[i];
+        }
+    }
+    for (int i = 0; i < numCoefficients; ++i) {
+        const double weight = regularization * std::max(size[i], 1.0) / statistics.size();
+        A[i][i] += weight;
+        b[i] += weight * scale * p[i];
+    }
+
+    CoefficientVector c;
+    try {
+        A.solve(c, b);
+    }
+    catch (const Dune::FMatrixError&) {
+        return prior;
+    }
+
+    for (auto& ci : c) {
+        if (!std::isfinite(ci)) {
+            return prior;
+        }
+        ci = std::max(ci, 0.0);
+    }
+    if (!(c[0] > 0.0)) {
+        return prior;
+    }
+    c /= c[0];
+
+    CellCostCoefficients result;
+    result.cell = c[0];
+    result.connection = c[1];
+    result.perforation = c[2];
+    result.msPerforation = c[3];
+    result.aquiferConnection = c[4];
+    return result;
+}
+
+std::vector<CellCostStatistics> readCellCostStatistics(const std::string& filename)
+{
+    std::vector<CellCostStatistics> statistics;
+    std::ifstream is(filename);
+    std::string line;
+    while (std::getline(is, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ls(line);
+        CellCostStatistics s;
+        ls >> s.cells >> s.connections >> s.perforations
+           >> s.msPerforations >> s.aquiferConnections >> s.seconds;
+        if (!ls) {
+            return {};
+        }
+        statistics.push_back(s);
+    }
+    return statistics;
+}
+
+void writeCellCostStatistics(const std::string& filename,
+                             const std::vector<CellCostStatistics>& statistics)
+{
+    std::ofstream os(filename);
+    os << "# cells connections perforations msPerforations aquiferConnections seconds\n";
+    os.precision(10);
+    for (const auto& s : statistics) {
+        os << s.cells << ' ' << s.connections << ' ' << s.perforations << ' '
+           << s.msPerforations << ' ' << s.aquiferConnections << ' ' << s.seconds << '\n';
+    }
+}
+
+} // namespace Opm
@@ -0,0 +1,149 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_CELL_COST_PARTITIONING_HEADER_INCLUDED
+#define OPM_CELL_COST_PARTITIONING_HEADER_INCLUDED
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class EclipseState;
+class Schedule;
+
+/*
+  Partitioning of the grid by the work attached to the cells rather than
+  by their number.
+
+  The cost of a cell is a linear combination of a few features: the cell
+  itself, its connections to other cells (faces and NNCs, which includes
+  the connections of numerical aquifers), the perforations of wells, with
+  an extra cost for those of multisegment wells, and the connections of
+  analytical aquifers. The coefficients are in units of the cost of a
+  plain cell. They can be given by the user or fitted to the time each
+  process has spent in a previous run of the same case.
+*/
+
+struct CellCostCoefficients
+{
+    double cell = 1.0;
+    double connection = 0.1;
+    double perforation = 4.0;
+    double msPerforation = 4.0;
+    double aquiferConnection = 1.0;
+};
+
+struct CellCostFeatures
+{
+    int connections = 0;
+    int perforations = 0;
+    int msPerforations = 0;
+    int aquiferConnections = 0;
+};
+
+/*
+  The features and the measured time of the cells of one process.
+*/
+struct CellCostStatistics
+{
+    double cells = 0.0;
+    double connections = 0.0;
+    double perforations = 0.0;
+    double msPerforations = 0.0;
+    double aquiferConnections = 0.0;
+    double seconds = 0.0;
+};
+
+/*! \brief Returns the features of the cells.
+ *! \param cartesianIndex Cartesian index of each cell
+ *! \param numNeighbours Number of faces to other cells of each cell
+ *! \param eclState Source of the NNCs and aquifer connections
+ *! \param schedule Source of the well connections at all report steps
+*/
+std::vector<CellCostFeatures> cellCostFeatures(const std::vector<int>& cartesianIndex,
+                                               const std::vector<int>& numNeighbours,
+                                               const EclipseState& eclState,
+                                               const Schedule& schedule);
+
+/*! \brief Returns the cost of the cells with the given features.
+*/
+std::vector<double> cellCosts(const std::vector<CellCostFeatures>& features,
+                              const CellCostCoefficients& coefficients);
+
+/*! \brief Returns the cells perforated by each well of the schedule at
+ *!        any of its report steps.
+ *! \param cartesianIndex Cartesian index of each cell
+*/
+std::vector<std::vector<int>> wellCells(const std::vector<int>& cartesianIndex,
+                                        const Schedule& schedule);
+
+/*! \brief Partitions cells by weighted recursive coordinate bisection.
+ *!
+ *! The cells are split along the direction of the largest extent, such
+ *! that the costs of both halves are in the ratio of the number of parts
+ *! assigned to them, until there is one part per subset.
+ *! \param centroids Centroid of each cell
+ *! \param costs Cost of each cell
+ *! \param keepTogether Sets of cells which end up in the same part, e.g.
+ *!                     the cells of a well. The sets may overlap. They
+ *!                     are ignored if keeping them together leaves
+ *!                     fewer movable groups of cells than parts.
+ *! \param numParts Number of parts; parts remain empty only if there
+ *!                 are fewer cells than parts
+ *! \return The part of each cell
+*/
+std::vector<int> partitionCellsByCost(const std::vector<std::array<double, 3>>& centroids,
+                                      const std::vector<double>& costs,
+                                      const std::vector<std::vector<int>>& keepTogether,
+                                      int numParts);
+
+/*! \brief Sums the features of the cells of one process.
+ *! \param features Features of the cells
+ *! \param interior Whether the cell is owned by the process
+ *! \param seconds Time spent by the process
+*/
+CellCostStatistics cellCostStatistics(const std::vector<CellCostFeatures>& features,
+                                      const std::vector<bool>& interior,
+                                      double seconds);
+
+/*! \brief Fits the coefficients to the statistics of a previous run.
+ *!
+ *! The fit is a least squares fit of the times of the processes, which
+ *! is regularized towards the prior coefficients, so that features that
+ *! the statistics cannot tell apart keep their prior ratio.
+ *! \return The fitted coefficients, relative to the cost of a cell, or
+ *!         the prior coefficients if the statistics do not allow a fit.
+*/
+CellCostCoefficients calibrateCellCosts(const std::vector<CellCostStatistics>& statistics,
+                                        const CellCostCoefficients& prior);
+
+/*! \brief Reads the statistics written by writeCellCostStatistics().
+ *! \return The statistics of each process, empty if the file cannot be read.
+*/
+std::vector<CellCostStatistics> readCellCostStatistics(const std::string& filename);
+
+/*! \brief Writes the statistics of all processes to a text file.
+*/
+void writeCellCostStatistics(const std::string& filename,
+                             const std::vector<CellCostStatistics>& statistics);
+
+} // namespace Opm
+
+#endif // OPM_CELL_COST_PARTITIONING_HEADER_INCLUDED
@@ -0,0 +1,262 @@
+/*
+  Copyright 2021 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/DeckCache.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/FileSystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Action/ASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/SICD.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/Valve.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQActive.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WList.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WListManager.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+
+#include <opm/simulators/utils/moduleVersion.hpp>
+
+#include <ebos/eclmpiserializer.hh>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr std::array<char,8> cacheMagic = {'O','P','M','D','E','C','K','C'};
+constexpr std::uint32_t cacheFormatVersion = 2;
+
+//! \brief The objects stored in the cache, serialized in this order.
+//! \details The EclipseState is not cached, since its serialization leaves
+//!          out the field properties and the input grid. It is created from
+//!          the cached deck instead.
+struct CachedObjects
+{
+    Opm::Deck& deck;
+    Opm::Schedule& schedule;
+    Opm::SummaryConfig& summaryConfig;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        deck.serializeOp(serializer);
+        schedule.serializeOp(serializer);
+        summaryConfig.serializeOp(serializer);
+    }
+};
+
+//! \brief 64 bit FNV-1a hash.
+std::uint64_t hashBytes(const char* data, std::size_t size,
+                        std::uint64_t hash = 14695981039346656037ull)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+//! \brief Hash of the contents of a file, or zero if it cannot be read.
+std::uint64_t hashFile(const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    if (!is)
+        return 0;
+
+    std::vector<char> chunk(std::size_t(1) << 20);
+    std::uint64_t hash = hashBytes(nullptr, 0);
+    while (is) {
+        is.read(chunk.data(), chunk.size());
+        hash = hashBytes(chunk.data(), is.gcount(), hash);
+    }
+    return hash;
+}
+
+template<class T>
+void writeValue(std::ostream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& os, const std::string& value)
+{
+    writeValue(os, static_cast<std::uint64_t>(value.size()));
+    os.write(value.data(), value.size());
+}
+
+template<class T>
+T readValue(std::istream& is)
+{
+    T value{};
+    if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        throw std::runtime_error("Unexpected end of file");
+    return value;
+}
+
+std::string readString(std::istream& is)
+{
+    std::string value(readValue<std::uint64_t>(is), '\0');
+    if (!is.read(value.data(), value.size()))
+        throw std::runtime_error("Unexpected end of file");
+    return value;
+}
+
+}
+
+namespace Opm {
+
+std::vector<std::string> deckInputFiles(const Deck& deck)
+{
+    std::set<std::string> files;
+    files.insert(deck.getDataFile());
+    for (std::size_t i = 0; i < deck.size(); ++i) {
+        const auto& fileName = deck.getKeyword(i).location().filename;
+        if (!fileName.empty())
+            files.insert(fileName);
+    }
+    return {files.begin(), files.end()};
+}
+
+bool loadDeckCache(const std::string& cacheFile,
+                   const std::string& settings,
+                   std::shared_ptr<Python> python,
+                   std::unique_ptr<Deck>& deck,
+                   std::unique_ptr<Schedule>& schedule,
+                   std::unique_ptr<SummaryConfig>& summaryConfig)
+{
+    std::ifstream is(cacheFile, std::ios::binary);
+    if (!is) {
+        OpmLog::info(fmt::format("Deck cache '{}' not found, parsing deck", cacheFile));
+        return false;
+    }
+
+    auto reject = [&cacheFile](const std::string& reason)
+    {
+        OpmLog::info(fmt::format("Deck cache '{}' not used: {}", cacheFile, reason));
+        return false;
+    };
+
+    try {
+        std::array<char,8> magic;
+        if (!is.read(magic.data(), magic.size()) || magic != cacheMagic)
+            return reject("not a deck cache file");
+        if (readValue<std::uint32_t>(is) != cacheFormatVersion)
+            return reject("file format version differs");
+        if (readString(is) != moduleVersion())
+            return reject("written by a different simulator version");
+        if (readString(is) != settings)
+            return reject("run settings differ");
+
+        const auto numFiles = readValue<std::uint64_t>(is);
+        for (std::uint64_t i = 0; i < numFiles; ++i) {
+            const auto fileName = readString(is);
+            const auto hash = readValue<std::uint64_t>(is);
+            if (hashFile(fileName) != hash)
+                return reject(fmt::format("input file '{}' changed", fileName));
+        }
+
+        const auto size = readValue<std::uint64_t>(is);
+        const auto hash = readValue<std::uint64_t>(is);
+        std::vector<char> buffer(size);
+        if (!is.read(buffer.data(), size))
+            return reject("file is truncated");
+        if (hashBytes(buffer.data(), size) != hash)
+            return reject("checksum mismatch");
+
+        auto newDeck = std::make_unique<Deck>();
+        auto newSchedule = std::make_unique<Schedule>(python);
+        auto newSummaryConfig = std::make_unique<SummaryConfig>();
+        CachedObjects objects{*newDeck, *newSchedule, *newSummaryConfig};
+
+        EclMpiSerializer ser(Dune::MPIHelper::getCollectiveCommunication());
+        ser.unpack(objects, std::move(buffer));
+
+        deck = std::move(newDeck);
+        schedule = std::move(newSchedule);
+        summaryConfig = std::move(newSummaryConfig);
+    }
+    catch (const std::exception& e) {
+        return reject(e.what());
+    }
+
+    OpmLog::info(fmt::format("Input loaded from deck cache '{}'", cacheFile));
+    return true;
+}
+
+void writeDeckCache(const std::string& cacheFile,
+                    const std::string& settings,
+                    const std::vector<std::string>& files,
+                    Deck& deck,
+                    Schedule& schedule,
+                    SummaryConfig& summaryConfig)
+{
+    CachedObjects objects{deck, schedule, summaryConfig};
+    EclMpiSerializer ser(Dune::MPIHelper::getCollectiveCommunication());
+    ser.pack(objects);
+
+    // Write to a temporary file of this writer and rename it, so that
+    // concurrent runs neither see nor overwrite a partially written cache.
+    std::random_device random;
+    const std::string tmpFile = fmt::format("{}.{}.{:08x}{:08x}.tmp", cacheFile,
+                                            ::getpid(), random(), random());
+    {
+        std::ofstream os(tmpFile, std::ios::binary | std::ios::trunc);
+        if (!os)
+            throw std::runtime_error(fmt::format("Could not open '{}' for writing", tmpFile));
+
+        os.write(cacheMagic.data(), cacheMagic.size());
+        writeValue(os, cacheFormatVersion);
+        writeString(os, moduleVersion());
+        writeString(os, settings);
+        writeValue(os, static_cast<std::uint64_t>(files.size()));
+        for (const auto& fileName : files) {
+            writeString(os, fileName);
+            writeValue(os, hashFile(fileName));
+        }
+        writeValue(os, static_cast<std::uint64_t>(ser.position()));
+        writeValue(os, hashBytes(ser.data(), ser.position()));
+        os.write(ser.data(), ser.position());
+        if (!os) {
+            os.close();
+            filesystem::remove(tmpFile);
+            throw std::runtime_error(fmt::format("Writing '{}' failed", tmpFile));
+        }
+    }
+    filesystem::rename(tmpFile, cacheFile);
+
+    OpmLog::info(fmt::format("Deck cache written to '{}'", cacheFile));
+}
+
+} // namespace Opm
@@ -0,0 +1,78 @@
+/*
+  Copyright 2021 Equinor AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_DECK_CACHE_HEADER_INCLUDED
+#define OPM_DECK_CACHE_HEADER_INCLUDED
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class Deck;
+class Python;
+class Schedule;
+class SummaryConfig;
+
+/*
+  Binary cache of the parsed input objects.
+
+  The cache file holds the serialized Deck, Schedule and SummaryConfig
+  together with a key identifying the input: the module version, the
+  settings which affect the parsed objects and a content hash of every input
+  file. The payload is protected by a checksum. A cache is only used if all
+  of these match. The EclipseState is not cached, it is created from the
+  cached deck, as its serialization does not include the field properties
+  and the input grid.
+*/
+
+/*! \brief Returns the names of all files the deck was read from.
+ *! \param deck Parsed deck
+*/
+std::vector<std::string> deckInputFiles(const Deck& deck);
+
+/*! \brief Loads the input objects from a cache file.
+ *! \param cacheFile Name of cache file
+ *! \param settings Settings the cached objects must have been created with
+ *! \param python Python handle to use for the schedule
+ *! \return True if the cache was valid and the objects were loaded.
+ *!         The objects are left untouched otherwise.
+*/
+bool loadDeckCache(const std::string& cacheFile,
+                   const std::string& settings,
+                   std::shared_ptr<Python> python,
+                   std::unique_ptr<Deck>& deck,
+                   std::unique_ptr<Schedule>& schedule,
+                   std::unique_ptr<SummaryConfig>& summaryConfig);
+
+/*! \brief Writes the input objects to a cache file.
+ *! \param cacheFile Name of cache file
+ *! \param settings Settings the objects were created with
+ *! \param files Input files the objects depend on
+*/
+void writeDeckCache(const std::string& cacheFile,
+                    const std::string& settings,
+                    const std::vector<std::string>& files,
+                    Deck& deck,
+                    Schedule& schedule,
+                    SummaryConfig& summaryConfig);
+
+} // namespace Opm
+
+#endif // OPM_DECK_CACHE_HEADER_INCLUDED
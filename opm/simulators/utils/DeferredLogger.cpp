@@ -21,6 +21,8 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <iterator>
+
 namespace Opm
 {
 
@@ -95,4 +97,12 @@ namespace Opm
         messages_.clear();
     }
 
+    void DeferredLogger::appendMessages(DeferredLogger& other)
+    {
+        messages_.insert(messages_.end(),
+                         std::make_move_iterator(other.messages_.begin()),
+                         std::make_move_iterator(other.messages_.end()));
+        other.messages_.clear();
+    }
+
 } // namespace Opm
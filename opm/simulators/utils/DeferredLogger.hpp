@@ -84,6 +84,10 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Move all messages of other to the end of the message
+        /// container, and clear the message container of other.
+        void appendMessages(DeferredLogger& other);
+
     private:
         std::vector<Message> messages_;
         friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger);
@@ -40,9 +40,16 @@
 namespace Opm {
 
 void eclStateBroadcast(EclipseState& eclState, Schedule& schedule,
-                       SummaryConfig& summaryConfig)
+                       SummaryConfig& summaryConfig, bool nodeShared)
 {
     Opm::EclMpiSerializer ser(Dune::MPIHelper::getCollectiveCommunication());
+    if (nodeShared) {
+        ser.broadcastNodeShared(eclState);
+        ser.broadcastNodeShared(schedule);
+        ser.broadcastNodeShared(summaryConfig);
+        return;
+    }
+
     ser.broadcast(eclState);
     ser.broadcast(schedule);
     ser.broadcast(summaryConfig);
@@ -29,9 +29,12 @@ class SummaryConfig;
  *! \param eclState EclipseState to broadcast
  *! \param schedule Schedule to broadcast
  *! \param summaryConfig SummaryConfig to broadcast
+ *! \param nodeShared Send the serialized data once per node and let the
+ *!        processes of a node de-serialize from a shared memory buffer.
+ *!        Every process still ends up with its own copy of the objects.
 */
 void eclStateBroadcast(EclipseState& eclState, Schedule& schedule,
-                       SummaryConfig& summaryConfig);
+                       SummaryConfig& summaryConfig, bool nodeShared = false);
 
 /// \brief Broadcasts an schedule from root node in parallel runs.
 void eclScheduleBroadcast(Schedule& schedule);
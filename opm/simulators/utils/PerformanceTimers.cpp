@@ -0,0 +1,97 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/PerformanceTimers.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+
+namespace {
+
+std::array<double, Opm::PerformanceTimers::NumSections> sectionSeconds{};
+std::array<long, Opm::PerformanceTimers::NumSections> sectionCalls{};
+
+} // Anonymous namespace
+
+namespace Opm {
+
+bool PerformanceTimers::enabled_ = false;
+
+void PerformanceTimers::enable(const bool enabled)
+{
+    enabled_ = enabled;
+}
+
+void PerformanceTimers::add(const Section section, const double seconds)
+{
+    sectionSeconds[section] += seconds;
+    ++sectionCalls[section];
+}
+
+double PerformanceTimers::seconds(const Section section)
+{
+    return sectionSeconds[section];
+}
+
+long PerformanceTimers::calls(const Section section)
+{
+    return sectionCalls[section];
+}
+
+const char* PerformanceTimers::name(const Section section)
+{
+    switch (section) {
+    case ReservoirLinearization: return "Reservoir linearization";
+    case WellAssembly:           return "Well assembly";
+    case IntensiveQuantities:    return "Intensive quantities";
+    case ConvergenceSweep:       return "Convergence sweep";
+    case ConvergenceReduction:   return "Convergence reduction";
+    case LinearSolverCommunication: return "Linear solver communication";
+    case OutputCollection:       return "Output collection";
+    default:                     return "Unknown";
+    }
+}
+
+void PerformanceTimers::reset()
+{
+    sectionSeconds.fill(0.0);
+    sectionCalls.fill(0);
+}
+
+std::string PerformanceTimers::formatHeader()
+{
+    return fmt::format("{:<28} {:>11} {:>11} {:>11} {:>9} {:>8} {:>10}\n",
+                       "Time per process [s]", "min", "mean", "max",
+                       "max/mean", "slowest", "calls");
+}
+
+std::string PerformanceTimers::formatRow(const std::string& name,
+                                         const double min, const double mean, const double max,
+                                         const int slowestRank, const double meanCalls)
+{
+    const double imbalance = mean > 0.0 ? max / mean : 1.0;
+    const std::string calls = meanCalls < 0.0 ? std::string("-") : fmt::format("{:.0f}", meanCalls);
+    return fmt::format("{:<28} {:>11.4g} {:>11.4g} {:>11.4g} {:>9.3f} {:>8} {:>10}\n",
+                       name, min, mean, max, imbalance, slowestRank, calls);
+}
+
+} // namespace Opm
@@ -0,0 +1,153 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PERFORMANCE_TIMERS_HEADER_INCLUDED
+#define OPM_PERFORMANCE_TIMERS_HEADER_INCLUDED
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Time spent by this process in the hot paths of the simulator.
+
+  The timers are disabled by default, which leaves a test of a flag in the
+  timed sections. They accumulate wall clock time of the calling thread and
+  must not be used inside of threaded regions.
+*/
+class PerformanceTimers
+{
+public:
+    enum Section {
+        ReservoirLinearization,
+        WellAssembly,
+        IntensiveQuantities,
+        ConvergenceSweep,
+        ConvergenceReduction,
+        LinearSolverCommunication,
+        OutputCollection,
+        NumSections
+    };
+
+    static void enable(bool enabled);
+
+    static bool enabled()
+    { return enabled_; }
+
+    static void add(Section section, double seconds);
+
+    static double seconds(Section section);
+
+    static long calls(Section section);
+
+    static const char* name(Section section);
+
+    static void reset();
+
+    /*! \brief Returns a table of the minimum, mean and maximum time of the
+     *!        processes for each section, and the rank of the slowest.
+     *! \param comm Communication of the processes, this is collective.
+     *! \param extra Further named times of this process to include, e.g.
+     *!              those of the simulator report.
+     *! \return The table on rank 0, an empty string on the other ranks.
+    */
+    template<class Communication>
+    static std::string report(const Communication& comm,
+                              const std::vector<std::pair<std::string, double>>& extra = {});
+
+private:
+    static std::string formatHeader();
+
+    static std::string formatRow(const std::string& name,
+                                 double min, double mean, double max,
+                                 int slowestRank, double meanCalls);
+
+    static bool enabled_;
+};
+
+/*
+  Adds the time between its construction and destruction to a section of
+  the performance timers, if they are enabled.
+*/
+class ScopedPerformanceTimer
+{
+public:
+    explicit ScopedPerformanceTimer(PerformanceTimers::Section section)
+        : section_(section)
+        , active_(PerformanceTimers::enabled())
+    {
+        if (active_) {
+            start_ = Clock::now();
+        }
+    }
+
+    ~ScopedPerformanceTimer()
+    {
+        if (active_) {
+            PerformanceTimers::add(section_, std::chrono::duration<double>(Clock::now() - start_).count());
+        }
+    }
+
+    ScopedPerformanceTimer(const ScopedPerformanceTimer&) = delete;
+    ScopedPerformanceTimer& operator=(const ScopedPerformanceTimer&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    PerformanceTimers::Section section_;
+    bool active_;
+    Clock::time_point start_;
+};
+
+template<class Communication>
+std::string PerformanceTimers::report(const Communication& comm,
+                                      const std::vector<std::pair<std::string, double>>& extra)
+{
+    std::string table;
+    auto addRow = [&comm, &table](const std::string& name, const double local, const double calls)
+    {
+        const double min = comm.min(local);
+        const double max = comm.max(local);
+        const double mean = comm.sum(local) / comm.size();
+        const int slowestRank = comm.min(local == max ? comm.rank() : comm.size());
+        const double meanCalls = comm.sum(calls) / comm.size();
+        if (comm.rank() == 0) {
+            table += formatRow(name, min, mean, max, slowestRank, meanCalls);
+        }
+    };
+
+    for (int section = 0; section < NumSections; ++section) {
+        const auto s = static_cast<Section>(section);
+        addRow(name(s), seconds(s), static_cast<double>(calls(s)));
+    }
+    for (const auto& [label, value] : extra) {
+        addRow(label, value, -1.0);
+    }
+
+    if (comm.rank() != 0) {
+        return {};
+    }
+    return formatHeader() + table;
+}
+
+} // namespace Opm
+
+#endif // OPM_PERFORMANCE_TIMERS_HEADER_INCLUDED
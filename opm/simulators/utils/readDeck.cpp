@@ -50,11 +50,13 @@
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
 
 #include "UnsupportedFlowKeywords.hpp"
 #include "PartiallySupportedFlowKeywords.hpp"
 #include <opm/simulators/flow/KeywordValidation.hpp>
 
+#include <opm/simulators/utils/DeckCache.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
 
@@ -183,13 +185,26 @@ void setupMessageLimiter(const Opm::MessageLimits msgLimits,  const std::string&
                                             msgLimits.getBugPrintLimit()}};
     stream_log->setMessageLimiter(std::make_shared<Opm::MessageLimiter>(10, limits));
 }
+
+// The action taken for each kind of input error, which decides whether a
+// deck is accepted at all.
+std::string parseContextSettings(const Opm::ParseContext* parseContext)
+{
+    std::string settings;
+    if (parseContext) {
+        for (const auto& [key, action] : *parseContext)
+            settings += fmt::format("{}:{},", key, static_cast<int>(action));
+    }
+    return settings;
+}
 }
 
 
 void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& deck, std::unique_ptr<Opm::EclipseState>& eclipseState,
               std::unique_ptr<Opm::Schedule>& schedule, std::unique_ptr<UDQState>& udqState, std::unique_ptr<Opm::SummaryConfig>& summaryConfig,
               std::unique_ptr<ErrorGuard> errorGuard, std::shared_ptr<Opm::Python>& python, std::unique_ptr<ParseContext> parseContext,
-              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval)
+              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval,
+              const std::string& deckCacheFile, bool nodeSharedBroadcast)
 {
     if (!errorGuard)
     {
@@ -202,6 +217,24 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
     if (rank==0) {
         try
         {
+            // The cache is only used when we create all the input objects ourselves.
+            bool useDeckCache = !deckCacheFile.empty() && !deck && !eclipseState && !schedule && !summaryConfig;
+            bool loadedFromCache = false;
+            const std::string cacheSettings = fmt::format("deck={};initFromRestart={};outputInterval={};checkDeck={};parseContext={}",
+                                                          deckFilename, initFromRestart,
+                                                          outputInterval.value_or(-1), checkDeck,
+                                                          parseContextSettings(parseContext.get()));
+#if HAVE_MPI
+            if (useDeckCache)
+                loadedFromCache = loadDeckCache(deckCacheFile, cacheSettings, python,
+                                                deck, schedule, summaryConfig);
+#else
+            if (useDeckCache) {
+                OpmLog::warning("Deck cache requires MPI support, ignoring --deck-cache");
+                useDeckCache = false;
+            }
+#endif
+
             if ( (!deck || !schedule || !summaryConfig ) && !parseContext)
             {
                 OPM_THROW(std::logic_error, "We need a parse context if deck, schedule, or summaryConfig are not initialized");
@@ -236,9 +269,10 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
               included here as a switch.
             */
             const auto& init_config = eclipseState->getInitConfig();
+            std::string rst_filename;
             if (init_config.restartRequested() && initFromRestart) {
                 const int report_step = init_config.getRestartStep();
-                const auto rst_filename = eclipseState->getIOConfig().getRestartFileName( init_config.getRestartRootName(), report_step, false );
+                rst_filename = eclipseState->getIOConfig().getRestartFileName( init_config.getRestartRootName(), report_step, false );
                 auto rst_file = std::make_shared<EclIO::ERst>(rst_filename);
                 auto rst_view = std::make_shared<EclIO::RestartFileView>(std::move(rst_file), report_step);
                 const auto rst_state = Opm::RestartIO::RstState::load(std::move(rst_view));
@@ -261,7 +295,24 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
                 summaryConfig = std::make_unique<Opm::SummaryConfig>(*deck, *schedule, eclipseState->fieldProps(), 
                                                                      eclipseState->aquifer(), *parseContext, *errorGuard);
 
-            Opm::checkConsistentArrayDimensions(*eclipseState, *schedule, *parseContext, *errorGuard);
+            if (!loadedFromCache)
+                Opm::checkConsistentArrayDimensions(*eclipseState, *schedule, *parseContext, *errorGuard);
+
+#if HAVE_MPI
+            if (useDeckCache && !loadedFromCache && !*errorGuard) {
+                auto files = deckInputFiles(*deck);
+                if (!rst_filename.empty())
+                    files.push_back(rst_filename);
+                try {
+                    writeDeckCache(deckCacheFile, cacheSettings, files,
+                                   *deck, *schedule, *summaryConfig);
+                }
+                catch (const std::exception& cache_error) {
+                    OpmLog::warning(fmt::format("Writing deck cache '{}' failed: {}",
+                                                deckCacheFile, cache_error.what()));
+                }
+            }
+#endif
         }
         catch(const OpmInputError& input_error) {
             failureMessage = input_error.what();
@@ -285,7 +336,7 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
 
     try
     {
-        Opm::eclStateBroadcast(*eclipseState, *schedule, *summaryConfig);
+        Opm::eclStateBroadcast(*eclipseState, *schedule, *summaryConfig, nodeSharedBroadcast);
     }
     catch(const std::exception& broadcast_error)
     {
@@ -53,10 +53,14 @@ FileOutputMode setupLogging(int mpi_rank_, const std::string& deck_filename, con
 /// \brief Reads the deck and creates all necessary objects if needed
 ///
 /// If pointers already contains objects then they are used otherwise they are created and can be used outside later.
+/// If deckCacheFile is non-empty and none of the objects are given, the deck, schedule and summary config are loaded
+/// from that binary cache when it matches the current input files and parse settings, and the cache is (re)written
+/// after parsing otherwise. The EclipseState is always created from the deck.
 void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Deck>& deck, std::unique_ptr<EclipseState>& eclipseState,
               std::unique_ptr<Schedule>& schedule, std::unique_ptr<UDQState>& udqState, std::unique_ptr<SummaryConfig>& summaryConfig,
               std::unique_ptr<ErrorGuard> errorGuard, std::shared_ptr<Python>& python, std::unique_ptr<ParseContext> parseContext,
-              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval);
+              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval,
+              const std::string& deckCacheFile = "", bool nodeSharedBroadcast = false);
 } // end namespace Opm
 
 #endif // OPM_READDECK_HEADER_INCLUDED
@@ -263,6 +263,20 @@ namespace Opm {
                 }
             }
 
+            // Sparsity pattern of the matrix added by addWellContributions():
+            // all the cells perforated by a well are coupled to each other.
+            std::vector<std::set<unsigned>> wellContributionsPattern(const std::size_t numCells) const
+            {
+                std::vector<std::set<unsigned>> pattern(numCells);
+                for ( const auto& well: well_container_ ) {
+                    const auto& cells = well->cells();
+                    for (const int cell : cells) {
+                        pattern[cell].insert(cells.begin(), cells.end());
+                    }
+                }
+                return pattern;
+            }
+
             // called at the beginning of a report step
             void beginReportStep(const int time_step);
 
@@ -287,8 +301,19 @@ namespace Opm {
             // a vector of all the wells.
             std::vector<WellInterfacePtr > well_container_{};
 
+            // index of each well in well_container_, rebuilt with the container
+            std::unordered_map<std::string, int> well_container_index_{};
+
             std::vector<bool> is_cell_perforated_{};
 
+            // CSR map from local cell to the (index in well_container_, perforation)
+            // pairs of the perforations in that cell.
+            std::vector<int> cell_perforation_offsets_{};
+            std::vector<std::pair<int,int>> cell_perforations_{};
+
+            // rebuild is_cell_perforated_ and the cell to perforation map
+            void updateCellPerforations();
+
             void initializeWellState(const int           timeStepIdx,
                                      const SummaryState& summaryState);
 
@@ -354,6 +379,7 @@ namespace Opm {
 
             void computePotentials(const std::size_t widx,
                                    const WellState& well_state_copy,
+                                   std::vector<double>& potentials,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
                                    DeferredLogger& deferred_logger) override;
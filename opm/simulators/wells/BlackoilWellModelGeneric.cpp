@@ -38,7 +38,9 @@
 #include <opm/simulators/wells/WellState.hpp>
 
 #include <cassert>
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -1051,6 +1053,12 @@ updateEclWells(const int timeStepIdx,
             this->prod_index_calc_[well_index].reInit(well);
         }
     }
+
+    // The group trees hold the status and efficiency factors of the wells
+    // and groups, which may just have been changed in the Schedule.
+    this->active_wgstate_.well_state.updateGroupTree(this->schedule_);
+    this->last_valid_wgstate_.well_state.updateGroupTree(this->schedule_);
+    this->nupcol_wgstate_.well_state.updateGroupTree(this->schedule_);
 }
 
 double
@@ -1582,6 +1590,27 @@ forceShutWellByNameIfPredictionMode(const std::string& wellname,
     return (well_was_shut == 1);
 }
 
+BlackoilWellModelGeneric::Checkpoint
+BlackoilWellModelGeneric::
+checkpoint() const
+{
+    return Checkpoint{this->active_wgstate_,
+                      this->last_valid_wgstate_,
+                      this->nupcol_wgstate_,
+                      this->wellTestState_};
+}
+
+void
+BlackoilWellModelGeneric::
+restore(const Checkpoint& checkpoint)
+{
+    this->active_wgstate_ = checkpoint.active_wgstate;
+    this->last_valid_wgstate_ = checkpoint.last_valid_wgstate;
+    this->nupcol_wgstate_ = checkpoint.nupcol_wgstate;
+    this->wellTestState_ = checkpoint.well_test_state;
+    this->closed_this_step_.clear();
+}
+
 void
 BlackoilWellModelGeneric::
 inferLocalShutWells()
@@ -1740,6 +1769,7 @@ updateWellPotentials(const int reportStepIdx,
     const bool write_restart_file = schedule().write_rst_file(reportStepIdx);
     auto exc_type = ExceptionType::NONE;
     std::string exc_msg;
+    std::vector<std::size_t> wells_to_compute;
     size_t widx = 0;
     for (const auto& well : well_container_generic_) {
         const bool needed_for_summary =
@@ -1780,10 +1810,64 @@ updateWellPotentials(const int reportStepIdx,
         const bool compute_potential = needPotentialsForOutput || needPotentialsForGuideRates;
         if (compute_potential)
         {
-            this->computePotentials(widx, well_state_copy, exc_msg, exc_type, deferred_logger);
+            wells_to_compute.push_back(widx);
         }
         ++widx;
     }
+
+    // The potentials of the wells are independent of each other: every well
+    // solves on its own copy and reads the shared well state only. Compute
+    // them concurrently, with per-well results, messages and exceptions
+    // which are merged in well order afterwards, so the outcome does not
+    // depend on the number of threads. Wells distributed over several
+    // processes communicate during their solves, and MPI is not set up for
+    // calls from several threads, so they are computed one after the other
+    // afterwards.
+    const int num_compute = wells_to_compute.size();
+    std::vector<std::vector<double>> potentials(num_compute);
+    std::vector<std::string> exc_msgs(num_compute);
+    std::vector<ExceptionType::ExcEnum> exc_types(num_compute, ExceptionType::NONE);
+    std::vector<DeferredLogger> loggers(num_compute);
+    std::vector<int> local_wells;
+    std::vector<int> distributed_wells;
+    for (int i = 0; i < num_compute; ++i) {
+        const auto& well = well_container_generic_[wells_to_compute[i]];
+        if (well->parallelWellInfo().communication().size() > 1)
+            distributed_wells.push_back(i);
+        else
+            local_wells.push_back(i);
+    }
+
+    auto computeWellPotentials = [&](const int i) {
+        // Potentials are left at zero for wells where the computation fails.
+        potentials[i].assign(this->numPhases(), 0.0);
+        this->computePotentials(wells_to_compute[i], well_state_copy, potentials[i],
+                                exc_msgs[i], exc_types[i], loggers[i]);
+    };
+
+    const int num_local = local_wells.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int j = 0; j < num_local; ++j) {
+        computeWellPotentials(local_wells[j]);
+    }
+    for (const int i : distributed_wells) {
+        computeWellPotentials(i);
+    }
+
+    for (int i = 0; i < num_compute; ++i) {
+        deferred_logger.appendMessages(loggers[i]);
+        if (exc_types[i] != ExceptionType::NONE) {
+            exc_type = exc_types[i];
+            exc_msg = exc_msgs[i];
+        }
+        const auto& well = well_container_generic_[wells_to_compute[i]];
+        auto well_potentials = this->wellState().wellPotentials(well->indexOfWell());
+        for (std::size_t p = 0; p < potentials[i].size(); ++p) {
+            well_potentials[p] = std::abs(potentials[i][p]);
+        }
+    }
     logAndCheckForExceptionsAndThrow(deferred_logger, exc_type,
                                      "computeWellPotentials() failed: " + exc_msg,
                                      terminal_output_);
@@ -157,6 +157,23 @@ public:
     bool forceShutWellByNameIfPredictionMode(const std::string& wellname,
                                              const double simulation_time);
 
+    /*
+      In-memory copy of the dynamic state of the well model, i.e. the
+      active, last valid and nupcol well and group states together with
+      the well test state. The well objects themselves are recreated
+      from this state at the beginning of every time step.
+    */
+    struct Checkpoint
+    {
+        WGState active_wgstate;
+        WGState last_valid_wgstate;
+        WGState nupcol_wgstate;
+        WellTestState well_test_state;
+    };
+
+    Checkpoint checkpoint() const;
+    void restore(const Checkpoint& checkpoint);
+
 protected:
 
     /*
@@ -348,6 +365,7 @@ protected:
 
     virtual void computePotentials(const std::size_t widx,
                                    const WellState& well_state_copy,
+                                   std::vector<double>& potentials,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
                                    DeferredLogger& deferred_logger) = 0;
@@ -21,6 +21,7 @@
 */
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
+#include <opm/simulators/utils/PerformanceTimers.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
@@ -28,6 +29,7 @@
 #include <opm/simulators/wells/VFPProperties.hpp>
 
 #include <algorithm>
+#include <numeric>
 #include <utility>
 
 #include <fmt/format.h>
@@ -253,12 +255,6 @@ namespace Opm {
             // optimize the usage of the following several member variables
             this->initWellContainer();
 
-            // update the updated cell flag
-            std::fill(is_cell_perforated_.begin(), is_cell_perforated_.end(), false);
-            for (auto& well : well_container_) {
-                well->updatePerforatedCell(is_cell_perforated_);
-            }
-
             // calculate the efficiency factors for each well
             calculateEfficiencyFactors(reportStepIdx);
 
@@ -504,24 +500,58 @@ namespace Opm {
         if (!is_cell_perforated_[elemIdx])
             return;
 
-        for (const auto& well : well_container_)
-            well->addCellRates(rate, elemIdx);
+        for (int slot = cell_perforation_offsets_[elemIdx];
+             slot < cell_perforation_offsets_[elemIdx + 1]; ++slot) {
+            const auto& [wellIdx, perfIdx] = cell_perforations_[slot];
+            well_container_[wellIdx]->addPerforationRates(rate, perfIdx);
+        }
     }
 
 
 
     template<typename TypeTag>
-    typename BlackoilWellModel<TypeTag>::WellInterfacePtr
+    void
     BlackoilWellModel<TypeTag>::
-    well(const std::string& wellName) const
+    updateCellPerforations()
     {
+        std::fill(is_cell_perforated_.begin(), is_cell_perforated_.end(), false);
+        for (auto& well : well_container_) {
+            well->updatePerforatedCell(is_cell_perforated_);
+        }
+
+        // count the perforations per cell and build the CSR offsets
+        cell_perforation_offsets_.assign(local_num_cells_ + 1, 0);
         for (const auto& well : well_container_) {
-            if (well->name() == wellName) {
-                return well;
+            for (const int cell : well->cells()) {
+                ++cell_perforation_offsets_[cell + 1];
             }
         }
-        OPM_THROW(std::invalid_argument, "The well with name " + wellName + " is not in the well Container");
-        return nullptr;
+        std::partial_sum(cell_perforation_offsets_.begin(), cell_perforation_offsets_.end(),
+                         cell_perforation_offsets_.begin());
+
+        cell_perforations_.resize(cell_perforation_offsets_.back());
+        std::vector<int> next(cell_perforation_offsets_.begin(), cell_perforation_offsets_.end() - 1);
+        for (std::size_t wellIdx = 0; wellIdx < well_container_.size(); ++wellIdx) {
+            const auto& cells = well_container_[wellIdx]->cells();
+            for (std::size_t perfIdx = 0; perfIdx < cells.size(); ++perfIdx) {
+                cell_perforations_[next[cells[perfIdx]]++] = {static_cast<int>(wellIdx),
+                                                               static_cast<int>(perfIdx)};
+            }
+        }
+    }
+
+
+
+    template<typename TypeTag>
+    typename BlackoilWellModel<TypeTag>::WellInterfacePtr
+    BlackoilWellModel<TypeTag>::
+    well(const std::string& wellName) const
+    {
+        const auto index = well_container_index_.find(wellName);
+        if (index == well_container_index_.end()) {
+            OPM_THROW(std::invalid_argument, "The well with name " + wellName + " is not in the well Container");
+        }
+        return well_container_[index->second];
     }
 
 
@@ -710,6 +740,14 @@ namespace Opm {
         well_container_generic_.clear();
         for (auto& w : well_container_)
           well_container_generic_.push_back(w.get());
+
+        well_container_index_.clear();
+        for (std::size_t wellIdx = 0; wellIdx < well_container_.size(); ++wellIdx) {
+            well_container_index_.emplace(well_container_[wellIdx]->name(), static_cast<int>(wellIdx));
+        }
+
+        // update the perforated cell flags and the cell to perforation map
+        updateCellPerforations();
     }
 
 
@@ -815,6 +853,8 @@ namespace Opm {
             return;
         }
 
+        ScopedPerformanceTimer timer(PerformanceTimers::WellAssembly);
+
 
         updatePerforationIntensiveQuantities();
 
@@ -1190,7 +1230,11 @@ namespace Opm {
             global_deferredLogger.logMessages();
         }
 
-        ConvergenceReport report = gatherConvergenceReport(local_report);
+        ConvergenceReport report;
+        {
+            ScopedPerformanceTimer timer(PerformanceTimers::ConvergenceReduction);
+            report = gatherConvergenceReport(local_report);
+        }
 
         // Log debug messages for NaN or too large residuals.
         if (terminal_output_) {
@@ -1316,12 +1360,11 @@ namespace Opm {
     void
     BlackoilWellModel<TypeTag>::computePotentials(const std::size_t widx,
                                                   const WellState& well_state_copy,
+                                                  std::vector<double>& potentials,
                                                   std::string& exc_msg,
                                                   ExceptionType::ExcEnum& exc_type,
                                                   DeferredLogger& deferred_logger)
     {
-        const int np = numPhases();
-        std::vector<double> potentials;
         const auto& well= well_container_[widx];
         try {
             well->computeWellPotentials(ebosSimulator_, well_state_copy, potentials, deferred_logger);
@@ -1338,12 +1381,6 @@ namespace Opm {
             exc_type = ExceptionType::DEFAULT;
             exc_msg = e.what();
         }
-        // Store it in the well state
-        // potentials is resized and set to zero in the beginning of well->ComputeWellPotentials
-        // and updated only if sucessfull. i.e. the potentials are zero for exceptions
-        for (int p = 0; p < np; ++p) {
-            this->wellState().wellPotentials(well->indexOfWell())[p] = std::abs(potentials[p]);
-        }
     }
 
 
@@ -1632,16 +1669,11 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     getWell(const std::string& well_name) const
     {
-        // finding the iterator of the well in wells_ecl
-        auto well = std::find_if(well_container_.begin(),
-                                     well_container_.end(),
-                                     [&well_name](const WellInterfacePtr& elem)->bool {
-                                         return elem->name() == well_name;
-                                     });
+        const auto index = well_container_index_.find(well_name);
 
-        assert(well != well_container_.end());
+        assert(index != well_container_index_.end());
 
-        return *well;
+        return well_container_[index->second];
     }
 
 
@@ -0,0 +1,125 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/wells/GroupTree.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Group/Group.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Opm {
+
+GroupTree::GroupTree(const Schedule& schedule, int report_step_arg)
+    : report_step(report_step_arg)
+{
+    const auto group_names = schedule.groupNames(report_step);
+    for (const auto& gname : group_names) {
+        this->group_index.emplace(gname, static_cast<int>(this->m_groups.size()));
+        this->m_groups.push_back({gname, -1, 1.0, {}, {}});
+    }
+
+    const auto well_names = schedule.wellNames(report_step);
+    for (const auto& wname : well_names) {
+        const auto& well = schedule.getWell(wname, report_step);
+        this->well_index.emplace(wname, static_cast<int>(this->m_wells.size()));
+        this->m_wells.push_back({wname,
+                                 -1,
+                                 well.getEfficiencyFactor(),
+                                 well.isInjector(),
+                                 well.getStatus() == Well::Status::SHUT});
+    }
+
+    for (auto& node : this->m_groups) {
+        const auto& group = schedule.getGroup(node.name, report_step);
+        node.efficiency_factor = group.getGroupEfficiencyFactor();
+
+        const auto self = this->groupIndex(node.name);
+        for (const auto& child : group.groups()) {
+            const auto child_index = this->groupIndex(child);
+            node.groups.push_back(child_index);
+            this->m_groups[child_index].parent = self;
+        }
+        for (const auto& child : group.wells()) {
+            const auto child_index = this->wellIndex(child);
+            node.wells.push_back(child_index);
+            this->m_wells[child_index].parent = self;
+        }
+    }
+}
+
+bool GroupTree::hasGroup(const std::string& name) const {
+    return this->group_index.count(name) > 0;
+}
+
+bool GroupTree::hasWell(const std::string& name) const {
+    return this->well_index.count(name) > 0;
+}
+
+int GroupTree::groupIndex(const std::string& name) const {
+    auto iter = this->group_index.find(name);
+    if (iter == this->group_index.end())
+        throw std::invalid_argument("No such group: " + name);
+
+    return iter->second;
+}
+
+int GroupTree::wellIndex(const std::string& name) const {
+    auto iter = this->well_index.find(name);
+    if (iter == this->well_index.end())
+        throw std::invalid_argument("No such well: " + name);
+
+    return iter->second;
+}
+
+const std::string& GroupTree::parent(const std::string& name) const {
+    const auto well_iter = this->well_index.find(name);
+    const int parent = (well_iter != this->well_index.end())
+        ? this->m_wells[well_iter->second].parent
+        : this->m_groups[this->groupIndex(name)].parent;
+
+    if (parent < 0)
+        throw std::invalid_argument("The group tree has no parent of: " + name);
+
+    return this->m_groups[parent].name;
+}
+
+std::vector<std::string> GroupTree::chainTopBot(const std::string& bottom, const std::string& top) const {
+    // Build the chain from bottom to top; 'bottom' can be a well or a group.
+    std::vector<std::string> chain;
+    chain.push_back(bottom);
+    chain.push_back(this->parent(bottom));
+    int parent = this->groupIndex(chain.back());
+    while (this->m_groups[parent].name != top) {
+        parent = this->m_groups[parent].parent;
+        if (parent < 0)
+            throw std::invalid_argument("Group " + top + " is not above " + bottom + " in the group tree");
+
+        chain.push_back(this->m_groups[parent].name);
+    }
+
+    // Reverse order and return.
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+}
@@ -0,0 +1,113 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GROUPTREE_HEADER_INCLUDED
+#define OPM_GROUPTREE_HEADER_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Opm {
+
+class Schedule;
+
+/*
+  The group tree of one report step, with the groups and wells numbered
+  consecutively. The group helpers walk the tree recursively many times per
+  Newton iteration; with the tree compiled once per report step they can do
+  that with integer indices instead of looking up every group and well of
+  the Schedule by name.
+
+  The children of a group are stored in the same order as in the Schedule,
+  so sums over the tree are accumulated in the same order as before.
+*/
+class GroupTree {
+public:
+    struct GroupNode {
+        std::string name;
+        int parent = -1;
+        double efficiency_factor = 1.0;
+        std::vector<int> groups;
+        std::vector<int> wells;
+    };
+
+    struct WellNode {
+        std::string name;
+        int parent = -1;
+        double efficiency_factor = 1.0;
+        bool injector = false;
+        bool shut = false;
+    };
+
+    GroupTree(const Schedule& schedule, int report_step);
+
+    int reportStep() const {
+        return this->report_step;
+    }
+
+    std::size_t numGroups() const {
+        return this->m_groups.size();
+    }
+
+    std::size_t numWells() const {
+        return this->m_wells.size();
+    }
+
+    bool hasGroup(const std::string& name) const;
+    bool hasWell(const std::string& name) const;
+
+    /*
+      Index of the group or well @name; throws std::invalid_argument if
+      there is no such group or well at the report step of the tree.
+    */
+    int groupIndex(const std::string& name) const;
+    int wellIndex(const std::string& name) const;
+
+    const GroupNode& group(int index) const {
+        return this->m_groups[index];
+    }
+
+    const WellNode& well(int index) const {
+        return this->m_wells[index];
+    }
+
+    /*
+      Name of the group containing the well or group @name.
+    */
+    const std::string& parent(const std::string& name) const;
+
+    /*
+      The chain of groups from @top down to @bottom, which can be a well or
+      a group, with both ends included.
+    */
+    std::vector<std::string> chainTopBot(const std::string& bottom, const std::string& top) const;
+
+private:
+    int report_step;
+    std::vector<GroupNode> m_groups;
+    std::vector<WellNode> m_wells;
+    std::unordered_map<std::string, int> group_index;
+    std::unordered_map<std::string, int> well_index;
+};
+
+}
+
+#endif
@@ -22,6 +22,8 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
 
+#include <cassert>
+
 namespace Dune
 {
 #if HAVE_MPI
@@ -46,48 +48,70 @@ struct CommPolicy<double*>
 namespace Opm
 {
 
+void CommunicateAboveBelow::GatherPlan::build(const IndexSet& local_indices,
+                                              const Communication& comm)
+{
+    // The global index used in the index set current_indices
+    // is the index of the perforation in ECL Schedule definition.
+    // This is assumed to give the topological order.
+    // allgather the index of the perforation in ECL schedule.
+    sizes.assign(comm.size(), 0);
+    displ.assign(comm.size() + 1, 0);
+    // Send the int for convenience. It will be used to get the place where the
+    // data comes from
+    using GlobalIndex = typename IndexSet::IndexPair::GlobalIndex;
+    using Pair = std::pair<GlobalIndex,int>;
+    std::vector<Pair> my_pairs;
+    my_pairs.reserve(local_indices.size());
+    send_local.clear();
+    send_local.reserve(local_indices.size());
+    for (const auto& pair: local_indices)
+    {
+        if (pair.local().attribute() == owner)
+        {
+            my_pairs.emplace_back(pair.global(), -1);
+            send_local.push_back(pair.local());
+        }
+    }
+    int mySize = my_pairs.size();
+    comm.allgather(&mySize, 1, sizes.data());
+    std::partial_sum(sizes.begin(), sizes.end(), displ.begin()+1);
+    std::vector<Pair> global_pairs(displ.back());
+    comm.allgatherv(my_pairs.data(), my_pairs.size(), global_pairs.data(), sizes.data(), displ.data());
+    // Set the the index where we receive
+    int count = 0;
+    std::for_each(global_pairs.begin(), global_pairs.end(), [&count](Pair& pair){ pair.second = count++;});
+    // sort the complete range to get the correct ordering
+    std::sort(global_pairs.begin(), global_pairs.end(),
+              [](const Pair& p1, const Pair& p2){ return p1.first < p2.first; } );
+    map_received.resize(global_pairs.size());
+    std::transform(global_pairs.begin(), global_pairs.end(), map_received.begin(),
+                   [](const Pair& pair){ return pair.second; });
+    perf_ecl_index.resize(global_pairs.size());
+    std::transform(global_pairs.begin(), global_pairs.end(), perf_ecl_index.begin(),
+                   [](const Pair& pair){ return pair.first; });
+    // Position of each local perforation in the global container
+    // (both ranges are sorted by the ecl index)
+    local_to_global.clear();
+    local_to_global.reserve(local_indices.size());
+    auto global_perf = perf_ecl_index.begin();
+    for (const auto& pair: local_indices)
+    {
+        global_perf = std::lower_bound(global_perf, perf_ecl_index.end(), pair.global());
+        assert(global_perf != perf_ecl_index.end());
+        assert(*global_perf == pair.global());
+        local_to_global.emplace_back(pair.local(), global_perf - perf_ecl_index.begin());
+    }
+}
+
 GlobalPerfContainerFactory::GlobalPerfContainerFactory(const IndexSet& local_indices, const Communication comm,
                                                        const int num_local_perfs)
-    : local_indices_(local_indices), comm_(comm)
+    : comm_(comm)
 {
     if ( comm_.size() > 1 )
     {
-        // The global index used in the index set current_indices
-        // is the index of the perforation in ECL Schedule definition.
-        // This is assumed to give the topological order.
-        // allgather the index of the perforation in ECL schedule and the value.
-        sizes_.resize(comm_.size());
-        displ_.resize(comm_.size() + 1, 0);
-        // Send the int for convenience. It will be used to get the place where the
-        // data comes from
-        using Pair = std::pair<GlobalIndex,int>;
-        std::vector<Pair> my_pairs;
-        my_pairs.reserve(local_indices_.size());
-        for (const auto& pair: local_indices_)
-        {
-            if (pair.local().attribute() == Attribute::owner)
-            {
-                my_pairs.emplace_back(pair.global(), -1);
-            }
-        }
-        int mySize = my_pairs.size();
-        comm_.allgather(&mySize, 1, sizes_.data());
-        std::partial_sum(sizes_.begin(), sizes_.end(), displ_.begin()+1);
-        std::vector<Pair> global_pairs(displ_.back());
-        comm_.allgatherv(my_pairs.data(), my_pairs.size(), global_pairs.data(), sizes_.data(), displ_.data());
-        // Set the the index where we receive
-        int count = 0;
-        std::for_each(global_pairs.begin(), global_pairs.end(), [&count](Pair& pair){ pair.second = count++;});
-        // sort the complete range to get the correct ordering
-        std::sort(global_pairs.begin(), global_pairs.end(),
-                  [](const Pair& p1, const Pair& p2){ return p1.first < p2.first; } );
-        map_received_.resize(global_pairs.size());
-        std::transform(global_pairs.begin(), global_pairs.end(), map_received_.begin(),
-                       [](const Pair& pair){ return pair.second; });
-        perf_ecl_index_.resize(global_pairs.size());
-        std::transform(global_pairs.begin(), global_pairs.end(), perf_ecl_index_.begin(),
-                       [](const Pair& pair){ return pair.first; });
-        num_global_perfs_ = global_pairs.size();
+        plan_.build(local_indices, comm_);
+        num_global_perfs_ = plan_.perf_ecl_index.size();
     }
     else
     {
@@ -95,7 +119,36 @@ GlobalPerfContainerFactory::GlobalPerfContainerFactory(const IndexSet& local_ind
     }
 }
 
+GlobalPerfContainerFactory::GlobalPerfContainerFactory(const CommunicateAboveBelow::GatherPlan& plan,
+                                                       const Communication comm,
+                                                       const int num_local_perfs)
+    : comm_(comm)
+{
+    if ( comm_.size() > 1 )
+    {
+        plan_ = plan;
+        num_global_perfs_ = plan_.perf_ecl_index.size();
+    }
+    else
+    {
+        num_global_perfs_ = num_local_perfs;
+    }
+}
 
+GlobalPerfContainerFactory::~GlobalPerfContainerFactory()
+{
+#if HAVE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized)
+    {
+        for (auto& entry : data_types_)
+        {
+            MPI_Type_free(&entry.second);
+        }
+    }
+#endif
+}
 
 std::vector<double> GlobalPerfContainerFactory::createGlobal(const std::vector<double>& local_perf_container,
                                                              std::size_t num_components) const
@@ -105,37 +158,41 @@ std::vector<double> GlobalPerfContainerFactory::createGlobal(const std::vector<d
 
     if (comm_.size() > 1)
     {
-        std::vector<Value> global_recv(perf_ecl_index_.size() * num_components);
+        recv_buffer_.resize(plan_.perf_ecl_index.size() * num_components);
         if (num_components == 1)
         {
             comm_.allgatherv(local_perf_container.data(), local_perf_container.size(),
-                             global_recv.data(), const_cast<int*>(sizes_.data()),
-                             const_cast<int*>(displ_.data()));
+                             recv_buffer_.data(), const_cast<int*>(plan_.sizes.data()),
+                             const_cast<int*>(plan_.displ.data()));
         }
         else
         {
 #if HAVE_MPI
-            // Create MPI type for sending num_components entries
-            MPI_Datatype data_type;
-            MPI_Type_contiguous(num_components, Dune::MPITraits<Value>::getType(), &data_type);
-            MPI_Type_commit(&data_type);
+            // MPI type for sending num_components entries, committed once per size
+            auto data_type = data_types_.find(num_components);
+            if (data_type == data_types_.end())
+            {
+                MPI_Datatype new_type;
+                MPI_Type_contiguous(num_components, Dune::MPITraits<Value>::getType(), &new_type);
+                MPI_Type_commit(&new_type);
+                data_type = data_types_.emplace(num_components, new_type).first;
+            }
             MPI_Allgatherv(local_perf_container.data(),
                            local_perf_container.size()/num_components,
-                           data_type, global_recv.data(), sizes_.data(),
-                           displ_.data(), data_type, comm_);
-            MPI_Type_free(&data_type);
+                           data_type->second, recv_buffer_.data(), plan_.sizes.data(),
+                           plan_.displ.data(), data_type->second, comm_);
 #endif
         }
 
         // reorder by ascending ecl index.
-        std::vector<Value> global_remapped(perf_ecl_index_.size() * num_components);
+        std::vector<Value> global_remapped(plan_.perf_ecl_index.size() * num_components);
         auto global = global_remapped.begin();
-        for (auto map_entry = map_received_.begin(); map_entry !=  map_received_.end(); ++map_entry)
+        for (auto map_entry = plan_.map_received.begin(); map_entry !=  plan_.map_received.end(); ++map_entry)
         {
             auto global_index = *map_entry * num_components;
 
             for(std::size_t i = 0; i < num_components; ++i)
-                *(global++) = global_recv[global_index++];
+                *(global++) = recv_buffer_[global_index++];
         }
         assert(global == global_remapped.end());
         return global_remapped;
@@ -156,16 +213,10 @@ void GlobalPerfContainerFactory::copyGlobalToLocal(const std::vector<double>& gl
 
     if (comm_.size() > 1)
     {
-        // assign the values (both ranges are sorted by the ecl index)
-        auto global_perf = perf_ecl_index_.begin();
-
-        for (const auto& pair: local_indices_)
+        for (const auto& [local_perf, global_perf] : plan_.local_to_global)
         {
-            global_perf = std::lower_bound(global_perf, perf_ecl_index_.end(), pair.global());
-            assert(global_perf != perf_ecl_index_.end());
-            assert(*global_perf == pair.global());
-            auto local_index = pair.local() * num_components;
-            auto global_index = (global_perf - perf_ecl_index_.begin()) * num_components;
+            auto local_index = local_perf * num_components;
+            auto global_index = global_perf * num_components;
             for (std::size_t i = 0; i < num_components; ++i)
                 local[local_index++] = global[global_index++];
         }
@@ -196,6 +247,7 @@ void CommunicateAboveBelow::clear()
     interface_.free();
     communicator_.free();
 #endif
+    plan_ = {};
     num_local_perfs_ = 0;
 }
 
@@ -225,6 +277,7 @@ int CommunicateAboveBelow::endReset()
         using ToSet = Dune::AllSet<Attribute>;
         interface_.build(remote_indices_, FromSet(), ToSet());
         communicator_.build<double*>(interface_);
+        plan_.build(current_indices_, comm_);
     }
 #endif
     return num_local_perfs_;
@@ -349,6 +402,11 @@ int CommunicateAboveBelow::numLocalPerfs() const
     return num_local_perfs_;
 }
 
+const CommunicateAboveBelow::GatherPlan& CommunicateAboveBelow::getGatherPlan() const
+{
+    return plan_;
+}
+
 ParallelWellInfo::ParallelWellInfo(const std::string& name,
                                    bool hasLocalCells)
     : name_(name), hasLocalCells_ (hasLocalCells),
@@ -399,7 +457,7 @@ void ParallelWellInfo::endReset()
 {
     int local_num_perfs = commAboveBelow_->endReset();
     globalPerfCont_
-        .reset(new GlobalPerfContainerFactory(commAboveBelow_->getIndexSet(),
+        .reset(new GlobalPerfContainerFactory(commAboveBelow_->getGatherPlan(),
                                               *comm_,
                                               local_num_perfs));
 }
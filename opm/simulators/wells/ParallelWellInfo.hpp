@@ -26,9 +26,14 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <iterator>
 #include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -120,48 +125,15 @@ public:
         else
         {
 #if HAVE_MPI
-            // The global index used in the index set current_indices
-            // is the index of the perforation in ECL Schedule definition.
-            // This is assumed to give the topological order that is used
-            // when doing the partial sum.
-            // allgather the index of the perforation in ECL schedule and the value.
             using Value = typename std::iterator_traits<RAIterator>::value_type;
-            std::vector<int> sizes(comm_.size());
-            std::vector<int> displ(comm_.size() + 1, 0);
-            using GlobalIndex = typename IndexSet::IndexPair::GlobalIndex;
-            using Pair = std::pair<GlobalIndex,Value>;
-            std::vector<Pair> my_pairs;
-            my_pairs.reserve(current_indices_.size());
-            for (const auto& pair: current_indices_)
+            if constexpr (std::is_same_v<Value, double>)
             {
-                if (pair.local().attribute() == owner)
-                {
-                    my_pairs.emplace_back(pair.global(), begin[pair.local()]);
-                }
+                partialSumPerfValuesImpl(begin, send_buffer_, recv_buffer_);
             }
-            int mySize = my_pairs.size();
-            comm_.allgather(&mySize, 1, sizes.data());
-            std::partial_sum(sizes.begin(), sizes.end(), displ.begin()+1);
-            std::vector<Pair> global_pairs(displ.back());
-            comm_.allgatherv(my_pairs.data(), my_pairs.size(), global_pairs.data(), sizes.data(), displ.data());
-            // sort the complete range to get the correct ordering
-            std::sort(global_pairs.begin(), global_pairs.end(),
-                      [](const Pair& p1, const Pair& p2){ return p1.first < p2.first; } );
-            std::vector<Value> sums(global_pairs.size());
-            std::transform(global_pairs.begin(), global_pairs.end(), sums.begin(),
-                           [](const Pair& p) { return p.second; });
-            std::partial_sum(sums.begin(), sums.end(),sums.begin());
-            // assign the values (both ranges are sorted by the ecl index)
-            auto global_pair = global_pairs.begin();
-            for (const auto& pair: current_indices_)
+            else
             {
-                global_pair = std::lower_bound(global_pair, global_pairs.end(),
-                                               pair.global(),
-                                               [](const Pair& val1, const GlobalIndex& val2)
-                                               { return val1.first < val2; });
-                assert(global_pair != global_pairs.end());
-                assert(global_pair->first == pair.global());
-                begin[pair.local()] = sums[global_pair - global_pairs.begin()];
+                std::vector<Value> send_buffer, recv_buffer;
+                partialSumPerfValuesImpl(begin, send_buffer, recv_buffer);
             }
 #else
             OPM_THROW(std::logic_error, "In a sequential run the size of the communicator should be 1!");
@@ -173,7 +145,66 @@ public:
     const IndexSet& getIndexSet() const;
 
     int numLocalPerfs() const;
+
+    /// \brief Plan for gathering the values of all owned perforations of a well.
+    ///
+    /// Only depends on the topology of the well and is therefore set up once
+    /// in endReset() and reused for every exchange.
+    struct GatherPlan
+    {
+        /// \brief Sets up the plan (collective on comm).
+        void build(const IndexSet& local_indices, const Communication& comm);
+
+        /// \brief sizes for allgatherv
+        std::vector<int> sizes;
+        /// \brief displacement for allgatherv
+        std::vector<int> displ;
+        /// \brief local indices of the owned perforations in the order they are sent.
+        std::vector<int> send_local;
+        /// \brief Mapping for storing gathered local values at the correct index.
+        std::vector<int> map_received;
+        /// \brief The index of a perforation in the schedule of ECL
+        ///
+        /// This is is sorted.
+        std::vector<int> perf_ecl_index;
+        /// \brief Pairs of local index and position in the global (sorted) container
+        std::vector<std::pair<int,int>> local_to_global;
+    };
+
+    /// \brief Get the gather plan for the local perforations.
+    const GatherPlan& getGatherPlan() const;
+
 private:
+    template<class RAIterator, class Value>
+    void partialSumPerfValuesImpl(RAIterator begin,
+                                  std::vector<Value>& send_buffer,
+                                  std::vector<Value>& recv_buffer) const
+    {
+        // The global index used in the index set current_indices
+        // is the index of the perforation in ECL Schedule definition.
+        // This is assumed to give the topological order that is used
+        // when doing the partial sum. The plan stores where each value
+        // ends up, so only the values need to be gathered.
+        send_buffer.resize(plan_.send_local.size());
+        std::transform(plan_.send_local.begin(), plan_.send_local.end(),
+                       send_buffer.begin(),
+                       [begin](int local) { return begin[local]; });
+        recv_buffer.resize(plan_.map_received.size());
+        comm_.allgatherv(send_buffer.data(), send_buffer.size(), recv_buffer.data(),
+                         const_cast<int*>(plan_.sizes.data()),
+                         const_cast<int*>(plan_.displ.data()));
+        // reorder by ascending ecl index (reusing the send buffer) and sum up.
+        send_buffer.resize(recv_buffer.size());
+        std::transform(plan_.map_received.begin(), plan_.map_received.end(),
+                       send_buffer.begin(),
+                       [&recv_buffer](int received) { return recv_buffer[received]; });
+        std::partial_sum(send_buffer.begin(), send_buffer.end(), send_buffer.begin());
+        for (const auto& [local, global] : plan_.local_to_global)
+        {
+            begin[local] = send_buffer[global];
+        }
+    }
+
     Communication comm_;
     /// \brief Mapping of the local well index to ecl index
     IndexSet current_indices_;
@@ -184,6 +215,11 @@ private:
     Dune::Interface interface_;
     Dune::BufferedCommunicator communicator_;
 #endif
+    /// \brief Gather plan used for partial sums.
+    GatherPlan plan_;
+    /// \brief Buffers reused for partial sums of doubles.
+    mutable std::vector<double> send_buffer_;
+    mutable std::vector<double> recv_buffer_;
     std::size_t num_local_perfs_{};
 };
 
@@ -211,6 +247,16 @@ public:
     GlobalPerfContainerFactory(const IndexSet& local_indices, const Communication comm,
                                int num_local_perfs);
 
+    /// \brief Constructor reusing the gather plan of the well.
+    /// \param plan completely set up gather plan for the local perforations
+    GlobalPerfContainerFactory(const CommunicateAboveBelow::GatherPlan& plan,
+                               const Communication comm, int num_local_perfs);
+
+    GlobalPerfContainerFactory(const GlobalPerfContainerFactory&) = delete;
+    GlobalPerfContainerFactory& operator=(const GlobalPerfContainerFactory&) = delete;
+
+    ~GlobalPerfContainerFactory();
+
     /// \brief Creates a container that holds values for all perforations
     /// \param local_perf_container Container with values attached to the local perforations.
     /// \param num_components the number of components per perforation.
@@ -228,19 +274,16 @@ public:
 
     int numGlobalPerfs() const;
 private:
-    const IndexSet& local_indices_;
     Communication comm_;
     int num_global_perfs_;
-    /// \brief sizes for allgatherv
-    std::vector<int> sizes_;
-    /// \brief displacement for allgatherv
-    std::vector<int> displ_;
-    /// \brief Mapping for storing gathered local values at the correct index.
-    std::vector<int> map_received_;
-    /// \brief The index of a perforation in the schedule of ECL
-    ///
-    /// This is is sorted.
-    std::vector<int> perf_ecl_index_;
+    /// \brief How to gather the values of all perforations.
+    CommunicateAboveBelow::GatherPlan plan_;
+    /// \brief Buffer reused for receiving the gathered values.
+    mutable std::vector<double> recv_buffer_;
+#if HAVE_MPI
+    /// \brief Committed MPI types for sending num_components entries.
+    mutable std::map<std::size_t, MPI_Datatype> data_types_;
+#endif
 };
 
 /// \brief Class encapsulating some information about parallel wells
@@ -27,6 +27,11 @@
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 
 #include <dune/grid/common/gridenums.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 #include <memory>
@@ -418,6 +423,16 @@ namespace Opm {
                 , rmap_ (region)
                 , attr_ (rmap_, Attributes())
             {
+                std::unordered_map<RegionId, int> regionIdx;
+                for (const auto& reg : rmap_.activeRegions()) {
+                    regionIdx.emplace(reg, regions_.size());
+                    regions_.push_back(reg);
+                }
+
+                cellRegionIdx_.resize(region.size(), -1);
+                for (std::size_t cell = 0; cell < cellRegionIdx_.size(); ++cell) {
+                    cellRegionIdx_[cell] = regionIdx[rmap_.region(cell)];
+                }
             }
 
 
@@ -432,124 +447,104 @@ namespace Opm {
             template <typename ElementContext, class EbosSimulator>
             void defineState(const EbosSimulator& simulator)
             {
+                // Sums per region, stored densely as numRegions blocks of
+                // hydrocarbon pore volume weighted sums followed by pore
+                // volume weighted sums.
+                const std::size_t numRegions = regions_.size();
+                std::vector<double> sums(numRegions * SumIdx::stride, 0.0);
 
-                // create map from cell to region
-                // and set all attributes to zero
-                for (const auto& reg : rmap_.activeRegions()) {
-                    auto& ra = attr_.attributes(reg);
-                    ra.pressure = 0.0;
-                    ra.temperature = 0.0;
-                    ra.rs = 0.0;
-                    ra.rv = 0.0;
-                    ra.pv = 0.0;
-                    ra.saltConcentration = 0.0;
-
-                }
-
-                // quantities for pore volume average
-                std::unordered_map<RegionId, Attributes> attributes_pv;
-
-                // quantities for hydrocarbon volume average
-                std::unordered_map<RegionId, Attributes> attributes_hpv;
-
-                for (const auto& reg : rmap_.activeRegions()) {
-                    attributes_pv.insert({reg, Attributes()});
-                    attributes_hpv.insert({reg, Attributes()});
-                }
-
-                ElementContext elemCtx( simulator );
                 const auto& gridView = simulator.gridView();
                 const auto& comm = gridView.comm();
+                const auto& model = simulator.model();
 
                 const auto& elemEndIt = gridView.template end</*codim=*/0>();
-                for (auto elemIt = gridView.template begin</*codim=*/0>();
-                     elemIt != elemEndIt;
-                     ++elemIt)
-                {
+                if (interiorCells_.empty()) {
+                    const auto& elemMapper = model.elementMapper();
+                    for (auto elemIt = gridView.template begin</*codim=*/0>();
+                         elemIt != elemEndIt;
+                         ++elemIt)
+                    {
+                        if (elemIt->partitionType() == Dune::InteriorEntity)
+                            interiorCells_.push_back(elemMapper.index(*elemIt));
+                    }
+                }
 
-                    const auto& elem = *elemIt;
-                    if (elem.partitionType() != Dune::InteriorEntity)
+                // Threaded reduction using the cached intensive quantities.
+                // Each thread accumulates into its own block which are added
+                // in thread order afterwards, so the result is deterministic.
+                int numThreads = 1;
+#ifdef _OPENMP
+                numThreads = omp_get_max_threads();
+#endif
+                std::vector<double> threadSums(numThreads * sums.size(), 0.0);
+                int cacheMiss = 0;
+                const int numCells = interiorCells_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:cacheMiss)
+#endif
+                for (int i = 0; i < numCells; ++i) {
+                    int threadId = 0;
+#ifdef _OPENMP
+                    threadId = omp_get_thread_num();
+#endif
+                    const unsigned cellIdx = interiorCells_[i];
+                    const auto* intQuants = model.cachedIntensiveQuantities(cellIdx, /*timeIdx=*/0);
+                    if (!intQuants) {
+                        ++cacheMiss;
                         continue;
-
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& intQuants = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0);
-                    const auto& fs = intQuants.fluidState();
-                    // use pore volume weighted averages.
-                    const double pv_cell =
-                            simulator.model().dofTotalVolume(cellIdx)
-                            * intQuants.porosity().value();
-
-                    // only count oil and gas filled parts of the domain
-                    double hydrocarbon = 1.0;
-                    const auto& pu = phaseUsage_;
-                    if (Details::PhaseUsed::water(pu)) {
-                        hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
                     }
+                    accumulateCell_(model, cellIdx, *intQuants,
+                                    threadSums.data() + threadId * sums.size());
+                }
 
-                    const int reg = rmap_.region(cellIdx);
-                    assert(reg >= 0);
-
-                    // sum p, rs, rv, and T.
-                    const double hydrocarbonPV = pv_cell*hydrocarbon;
-                    if (hydrocarbonPV > 0.) {
-                        auto& attr = attributes_hpv[reg];
-                        attr.pv += hydrocarbonPV;
-                        attr.pressure += fs.pressure(FluidSystem::oilPhaseIdx).value() * hydrocarbonPV;
-                        attr.rs += fs.Rs().value() * hydrocarbonPV;
-                        attr.rv += fs.Rv().value() * hydrocarbonPV;
-                        attr.temperature += fs.temperature(FluidSystem::oilPhaseIdx).value() * hydrocarbonPV;
-                        attr.saltConcentration += fs.saltConcentration().value() * hydrocarbonPV;
+                if (cacheMiss == 0) {
+                    for (int t = 0; t < numThreads; ++t) {
+                        const double* ts = threadSums.data() + t * sums.size();
+                        for (std::size_t j = 0; j < sums.size(); ++j) {
+                            sums[j] += ts[j];
+                        }
                     }
-
-                    if (pv_cell > 0.) {
-                        auto& attr = attributes_pv[reg];
-                        attr.pv += pv_cell;
-                        attr.pressure += fs.pressure(FluidSystem::oilPhaseIdx).value() * pv_cell;
-                        attr.rs += fs.Rs().value() * pv_cell;
-                        attr.rv += fs.Rv().value() * pv_cell;
-                        attr.temperature += fs.temperature(FluidSystem::oilPhaseIdx).value() * pv_cell;
-                        attr.saltConcentration += fs.saltConcentration().value() * pv_cell;
+                } else {
+                    // Intensive quantities are not cached, compute them.
+                    ElementContext elemCtx( simulator );
+                    for (auto elemIt = gridView.template begin</*codim=*/0>();
+                         elemIt != elemEndIt;
+                         ++elemIt)
+                    {
+                        const auto& elem = *elemIt;
+                        if (elem.partitionType() != Dune::InteriorEntity)
+                            continue;
+
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                        const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+                        accumulateCell_(model, cellIdx,
+                                        elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0),
+                                        sums.data());
                     }
                 }
 
-                for (const auto& reg : rmap_.activeRegions()) {
-                      auto& ra = attr_.attributes(reg);
-                      const double hpv_sum = comm.sum(attributes_hpv[reg].pv);
-                      // TODO: should we have some epsilon here instead of zero?
-                      if (hpv_sum > 0.) {
-                          const auto& attri_hpv = attributes_hpv[reg];
-                          const double p_hpv_sum = comm.sum(attri_hpv.pressure);
-                          const double T_hpv_sum = comm.sum(attri_hpv.temperature);
-                          const double rs_hpv_sum = comm.sum(attri_hpv.rs);
-                          const double rv_hpv_sum = comm.sum(attri_hpv.rv);
-                          const double sc_hpv_sum = comm.sum(attri_hpv.saltConcentration);
-
-                          ra.pressure = p_hpv_sum / hpv_sum;
-                          ra.temperature = T_hpv_sum / hpv_sum;
-                          ra.rs = rs_hpv_sum / hpv_sum;
-                          ra.rv = rv_hpv_sum / hpv_sum;
-                          ra.pv = hpv_sum;
-                          ra.saltConcentration = sc_hpv_sum / hpv_sum;
-                      } else {
-                          // using the pore volume to do the averaging
-                          const auto& attri_pv = attributes_pv[reg];
-                          const double pv_sum = comm.sum(attri_pv.pv);
-                          assert(pv_sum > 0.);
-                          const double p_pv_sum = comm.sum(attri_pv.pressure);
-                          const double T_pv_sum = comm.sum(attri_pv.temperature);
-                          const double rs_pv_sum = comm.sum(attri_pv.rs);
-                          const double rv_pv_sum = comm.sum(attri_pv.rv);
-                          const double sc_pv_sum = comm.sum(attri_pv.saltConcentration);
-
-                          ra.pressure = p_pv_sum / pv_sum;
-                          ra.temperature = T_pv_sum / pv_sum;
-                          ra.rs = rs_pv_sum / pv_sum;
-                          ra.rv = rv_pv_sum / pv_sum;
-                          ra.pv = pv_sum;
-                          ra.saltConcentration = sc_pv_sum / pv_sum;
-                      }
+                // One collective for all regions and quantities.
+                if (!sums.empty()) {
+                    comm.sum(sums.data(), sums.size());
+                }
+
+                for (std::size_t r = 0; r < numRegions; ++r) {
+                    auto& ra = attr_.attributes(regions_[r]);
+                    const double* regionSums = sums.data() + r * SumIdx::stride;
+                    // TODO: should we have some epsilon here instead of zero?
+                    // Otherwise use the pore volume to do the averaging.
+                    const double* avg = regionSums[SumIdx::pv] > 0.
+                        ? regionSums : regionSums + SumIdx::numFields;
+                    const double pv_sum = avg[SumIdx::pv];
+                    assert(pv_sum > 0.);
+
+                    ra.pressure = avg[SumIdx::pressure] / pv_sum;
+                    ra.temperature = avg[SumIdx::temperature] / pv_sum;
+                    ra.rs = avg[SumIdx::rs] / pv_sum;
+                    ra.rv = avg[SumIdx::rv] / pv_sum;
+                    ra.pv = pv_sum;
+                    ra.saltConcentration = avg[SumIdx::saltConcentration] / pv_sum;
                 }
             }
 
@@ -812,6 +807,77 @@ namespace Opm {
              */
             const RegionMapping<Region> rmap_;
 
+            /**
+             * Active regions, in the order used for the dense sums.
+             */
+            std::vector<RegionId> regions_;
+
+            /**
+             * Position of the region of each cell in regions_.
+             */
+            std::vector<int> cellRegionIdx_;
+
+            /**
+             * Interior cells, set up on first call of defineState().
+             */
+            std::vector<unsigned> interiorCells_;
+
+            /**
+             * Layout of the per-region sums in defineState().
+             */
+            struct SumIdx {
+                enum { pv, pressure, temperature, rs, rv, saltConcentration,
+                       numFields, stride = 2 * numFields };
+            };
+
+            /**
+             * Adds the hydrocarbon pore volume and pore volume weighted
+             * contributions of a cell to the sums of its region.
+             */
+            template <class Model, class IntensiveQuantities>
+            void accumulateCell_(const Model& model,
+                                 const unsigned cellIdx,
+                                 const IntensiveQuantities& intQuants,
+                                 double* sums) const
+            {
+                const auto& fs = intQuants.fluidState();
+                // use pore volume weighted averages.
+                const double pv_cell =
+                        model.dofTotalVolume(cellIdx)
+                        * intQuants.porosity().value();
+
+                // only count oil and gas filled parts of the domain
+                double hydrocarbon = 1.0;
+                const auto& pu = phaseUsage_;
+                if (Details::PhaseUsed::water(pu)) {
+                    hydrocarbon -= fs.saturation(FluidSystem::waterPhaseIdx).value();
+                }
+
+                const int reg = cellRegionIdx_[cellIdx];
+                assert(reg >= 0);
+                double* regionSums = sums + reg * SumIdx::stride;
+
+                auto add = [&fs](double* attr, const double weight)
+                {
+                    attr[SumIdx::pv] += weight;
+                    attr[SumIdx::pressure] += fs.pressure(FluidSystem::oilPhaseIdx).value() * weight;
+                    attr[SumIdx::rs] += fs.Rs().value() * weight;
+                    attr[SumIdx::rv] += fs.Rv().value() * weight;
+                    attr[SumIdx::temperature] += fs.temperature(FluidSystem::oilPhaseIdx).value() * weight;
+                    attr[SumIdx::saltConcentration] += fs.saltConcentration().value() * weight;
+                };
+
+                // sum p, rs, rv, and T.
+                const double hydrocarbonPV = pv_cell*hydrocarbon;
+                if (hydrocarbonPV > 0.) {
+                    add(regionSums, hydrocarbonPV);
+                }
+
+                if (pv_cell > 0.) {
+                    add(regionSums + SumIdx::numFields, pv_cell);
+                }
+            }
+
             /**
              * Derived property attributes for each active region.
              */
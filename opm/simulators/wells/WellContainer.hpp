@@ -21,6 +21,8 @@
 #define OPM_WELL_CONTAINER_HEADER_INCLUDED
 
 #include <initializer_list>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -38,6 +40,10 @@ namespace Opm {
   The class is created to facilitate safe and piecewise refactoring of the
   WellState class, and might have a short life in the
   development timeline.
+
+  The name -> index map is shared between copies of a container and only
+  cloned when a copy adds new wells, so copying a well state does not copy
+  the well names once per quantity.
 */
 
 
@@ -54,7 +60,7 @@ public:
     }
 
     bool empty() const {
-        return this->index_map.empty();
+        return this->m_data.empty();
     }
 
     std::size_t size() const {
@@ -62,33 +68,33 @@ public:
     }
 
     void add(const std::string& name, T&& value) {
-        if (index_map.count(name) != 0)
+        if (this->has(name))
             throw std::logic_error("An object with name: " + name + " already exists in container");
 
-        this->index_map.emplace(name, this->m_data.size());
+        this->mutable_index_map().emplace(name, this->m_data.size());
         this->m_data.push_back(std::forward<T>(value));
     }
 
     void add(const std::string& name, const T& value) {
-        if (index_map.count(name) != 0)
+        if (this->has(name))
             throw std::logic_error("An object with name: " + name + " already exists in container");
 
-        this->index_map.emplace(name, this->m_data.size());
+        this->mutable_index_map().emplace(name, this->m_data.size());
         this->m_data.push_back(value);
     }
 
     bool has(const std::string& name) const {
-        return (index_map.count(name) != 0);
+        return (this->index_map && this->index_map->count(name) != 0);
     }
 
 
     void update(const std::string& name, T&& value) {
-        auto index = this->index_map.at(name);
+        auto index = this->index_of(name);
         this->m_data[index] = std::forward<T>(value);
     }
 
     void update(const std::string& name, const T& value) {
-        auto index = this->index_map.at(name);
+        auto index = this->index_of(name);
         this->m_data[index] = value;
     }
 
@@ -105,10 +111,10 @@ public:
       in both containers.
     */
     void copy_welldata(const WellContainer<T>& other) {
-        if (this->index_map == other.index_map)
+        if (this->same_wells(other))
             this->m_data = other.m_data;
-        else {
-            for (const auto& [name, index] : this->index_map)
+        else if (this->index_map) {
+            for (const auto& [name, index] : *this->index_map)
                 this->update_if(index, name, other);
         }
     }
@@ -118,8 +124,8 @@ public:
       exist in both containers, otherwise an exception is thrown.
     */
     void copy_welldata(const WellContainer<T>& other, const std::string& name) {
-        auto this_index = this->index_map.at(name);
-        auto other_index = other.index_map.at(name);
+        auto this_index = this->index_of(name);
+        auto other_index = other.index_of(name);
         this->m_data[this_index] = other.m_data[other_index];
     }
 
@@ -132,18 +138,18 @@ public:
     }
 
     T& operator[](const std::string& name) {
-        auto index = this->index_map.at(name);
+        auto index = this->index_of(name);
         return this->m_data[index];
     }
 
     const T& operator[](const std::string& name) const {
-        auto index = this->index_map.at(name);
+        auto index = this->index_of(name);
         return this->m_data[index];
     }
 
     void clear() {
         this->m_data.clear();
-        this->index_map.clear();
+        this->index_map.reset();
     }
 
     typename std::vector<T>::const_iterator begin() const {
@@ -159,27 +165,60 @@ public:
     }
 
     std::optional<int> well_index(const std::string& wname) const {
-        auto index_iter = this->index_map.find(wname);
-        if (index_iter != this->index_map.end())
+        if (!this->index_map)
+            return std::nullopt;
+
+        auto index_iter = this->index_map->find(wname);
+        if (index_iter != this->index_map->end())
             return index_iter->second;
 
         return std::nullopt;
     }
 
+    /*
+      True if both containers hold the same wells in the same order.
+    */
+    bool same_wells(const WellContainer<T>& other) const {
+        if (this->index_map == other.index_map)
+            return true;
+
+        if (!this->index_map || !other.index_map)
+            return this->empty() && other.empty();
+
+        return *this->index_map == *other.index_map;
+    }
+
 
 private:
+    using IndexMap = std::unordered_map<std::string, std::size_t>;
+
+    std::size_t index_of(const std::string& name) const {
+        if (!this->index_map)
+            throw std::out_of_range("No well with name: " + name + " in container");
+
+        return this->index_map->at(name);
+    }
+
+    IndexMap& mutable_index_map() {
+        if (!this->index_map)
+            this->index_map = std::make_shared<IndexMap>();
+        else if (this->index_map.use_count() > 1)
+            this->index_map = std::make_shared<IndexMap>(*this->index_map);
+
+        return *this->index_map;
+    }
+
     void update_if(std::size_t index, const std::string& name, const WellContainer<T>& other) {
-        auto other_iter = other.index_map.find(name);
-        if (other_iter == other.index_map.end())
+        auto other_index = other.well_index(name);
+        if (!other_index)
             return;
 
-        auto other_index = other_iter->second;
-        this->m_data[index] = other.m_data[other_index];
+        this->m_data[index] = other.m_data[*other_index];
     }
 
 
     std::vector<T> m_data;
-    std::unordered_map<std::string, std::size_t> index_map;
+    std::shared_ptr<IndexMap> index_map;
 };
 
 
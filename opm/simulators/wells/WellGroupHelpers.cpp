@@ -28,10 +28,11 @@
 #include <opm/simulators/utils/DeferredLogger.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/wells/GroupState.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/TargetCalculator.hpp>
 #include <opm/simulators/wells/VFPProdProperties.hpp>
 #include <opm/simulators/wells/WellState.hpp>
-#include <opm/simulators/wells/WellContainer.hpp>
+#include <opm/simulators/wells/WellPhaseContainer.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -58,6 +59,97 @@ namespace {
 
         return {oilRate, gasRate, waterRate};
     }
+
+    // Sum of efficiency weighted rates of the producers or injectors
+    // owned by this process in the subtree of group @group_index,
+    // with the rate of a well given by @well_rate(well_index).
+    template <class WellRate>
+    double sumWellRates(const Opm::GroupTree& tree,
+                        const int group_index,
+                        const Opm::WellState& wellState,
+                        const bool injector,
+                        const WellRate& well_rate)
+    {
+        const auto& group = tree.group(group_index);
+
+        double rate = 0.0;
+        for (const int child : group.groups) {
+            rate += sumWellRates(tree, child, wellState, injector, well_rate);
+        }
+
+        const auto& end = wellState.wellMap().end();
+        for (const int child : group.wells) {
+            const auto& well = tree.well(child);
+            // only count producers or injectors
+            if (well.injector != injector)
+                continue;
+
+            if (well.shut)
+                continue;
+
+            const auto& it = wellState.wellMap().find(well.name);
+            if (it == end) // the well is not found
+                continue;
+
+            int well_index = it->second[0];
+
+            if (! wellState.wellIsOwned(well_index, well.name) ) // Only sum once
+            {
+                continue;
+            }
+
+            if (injector)
+                rate += well.efficiency_factor * well_rate(well_index);
+            else
+                rate -= well.efficiency_factor * well_rate(well_index);
+        }
+        return group.efficiency_factor * rate;
+    }
+
+    int groupControlledWells(const Opm::GroupTree& tree,
+                             const int group_index,
+                             const Opm::WellState& well_state,
+                             const Opm::GroupState& group_state,
+                             const std::string& always_included_child,
+                             const bool is_production_group,
+                             const Opm::Phase injection_phase)
+    {
+        using Opm::Group;
+
+        const auto& group = tree.group(group_index);
+        int num_wells = 0;
+        for (const int child : group.groups) {
+            const auto& child_group = tree.group(child).name;
+
+            bool included = (child_group == always_included_child);
+            if (is_production_group) {
+                const auto ctrl = group_state.production_control(child_group);
+                included = included || (ctrl == Group::ProductionCMode::FLD) || (ctrl == Group::ProductionCMode::NONE);
+            } else {
+                const auto ctrl = group_state.injection_control(child_group, injection_phase);
+                included = included || (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
+            }
+
+            if (included) {
+                num_wells
+                    += groupControlledWells(tree, child, well_state, group_state, always_included_child, is_production_group, injection_phase);
+            }
+        }
+        for (const int child : group.wells) {
+            const auto& child_well = tree.well(child).name;
+
+            bool included = (child_well == always_included_child);
+            if (is_production_group) {
+                included = included || well_state.isProductionGrup(child_well);
+            } else {
+                included = included || well_state.isInjectionGrup(child_well);
+            }
+            if (included) {
+                ++num_wells;
+            }
+        }
+        return num_wells;
+    }
 } // namespace Anonymous
 
 namespace Opm
@@ -126,7 +218,7 @@ namespace WellGroupHelpers
                 schedule.getGroup(group.parent(), reportStepIdx), schedule, reportStepIdx, factor);
     }
 
-    double sumWellPhaseRates(const WellContainer<std::vector<double>>& rates,
+    double sumWellPhaseRates(const WellPhaseContainer& rates,
                              const Group& group,
                              const Schedule& schedule,
                              const WellState& wellState,
@@ -134,43 +226,9 @@ namespace WellGroupHelpers
                              const int phasePos,
                              const bool injector)
     {
-
-        double rate = 0.0;
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            rate += sumWellPhaseRates(rates, groupTmp, schedule, wellState, reportStepIdx, phasePos, injector);
-        }
-        const auto& end = wellState.wellMap().end();
-
-        for (const std::string& wellName : group.wells()) {
-            const auto& it = wellState.wellMap().find(wellName);
-            if (it == end) // the well is not found
-                continue;
-
-            int well_index = it->second[0];
-
-            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
-            {
-                continue;
-            }
-
-            const auto& wellEcl = schedule.getWell(wellName, reportStepIdx);
-            // only count producers or injectors
-            if ((wellEcl.isProducer() && injector) || (wellEcl.isInjector() && !injector))
-                continue;
-
-            if (wellEcl.getStatus() == Well::Status::SHUT)
-                continue;
-
-            double factor = wellEcl.getEfficiencyFactor();
-            const auto& well_rates = rates[well_index];
-            if (injector)
-                rate += factor * well_rates[phasePos];
-            else
-                rate -= factor * well_rates[phasePos];
-        }
-        const auto& gefac = group.getGroupEfficiencyFactor();
-        return gefac * rate;
+        const auto tree = wellState.groupTree(schedule, reportStepIdx);
+        return ::sumWellRates(*tree, tree->groupIndex(group.name()), wellState, injector,
+                              [&rates, phasePos](const int well_index) { return rates[well_index][phasePos]; });
     }
 
     double sumWellRates(const Group& group,
@@ -200,41 +258,9 @@ namespace WellGroupHelpers
                            const int reportStepIdx,
                            const bool injector)
     {
-
-        double rate = 0.0;
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            rate += sumSolventRates(groupTmp, schedule, wellState, reportStepIdx, injector);
-        }
-        const auto& end = wellState.wellMap().end();
-        for (const std::string& wellName : group.wells()) {
-            const auto& it = wellState.wellMap().find(wellName);
-            if (it == end) // the well is not found
-                continue;
-
-            int well_index = it->second[0];
-
-            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
-            {
-                continue;
-            }
-
-            const auto& wellEcl = schedule.getWell(wellName, reportStepIdx);
-            // only count producers or injectors
-            if ((wellEcl.isProducer() && injector) || (wellEcl.isInjector() && !injector))
-                continue;
-
-            if (wellEcl.getStatus() == Well::Status::SHUT)
-                continue;
-
-            double factor = wellEcl.getEfficiencyFactor();
-            if (injector)
-                rate += factor * wellState.solventWellRate(well_index);
-            else
-                rate -= factor * wellState.solventWellRate(well_index);
-        }
-        const auto& gefac = group.getGroupEfficiencyFactor();
-        return gefac * rate;
+        const auto tree = wellState.groupTree(schedule, reportStepIdx);
+        return ::sumWellRates(*tree, tree->groupIndex(group.name()), wellState, injector,
+                              [&wellState](const int well_index) { return wellState.solventWellRate(well_index); });
     }
 
     void updateGuideRatesForInjectionGroups(const Group& group,
@@ -777,7 +803,8 @@ namespace WellGroupHelpers
                         const GuideRateModel::Target target,
                         const PhaseUsage& pu)
     {
-        if (schedule.hasWell(name, reportStepIdx)) {
+        const auto tree = wellState.groupTree(schedule, reportStepIdx);
+        if (tree->hasWell(name)) {
             return guideRate->get(name, target, getWellRateVector(wellState, pu, name));
         }
 
@@ -786,9 +813,10 @@ namespace WellGroupHelpers
         }
 
         double totalGuideRate = 0.0;
-        const Group& group = schedule.getGroup(name, reportStepIdx);
+        const auto& group = tree->group(tree->groupIndex(name));
 
-        for (const std::string& groupName : group.groups()) {
+        for (const int child : group.groups) {
+            const std::string& groupName = tree->group(child).name;
             const Group::ProductionCMode& currentGroupControl = group_state.production_control(groupName);
             if (currentGroupControl == Group::ProductionCMode::FLD
                 || currentGroupControl == Group::ProductionCMode::NONE) {
@@ -797,13 +825,14 @@ namespace WellGroupHelpers
             }
         }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
+        for (const int child : group.wells) {
+            const auto& wellTmp = tree->well(child);
+            const std::string& wellName = wellTmp.name;
 
-            if (wellTmp.isInjector())
+            if (wellTmp.injector)
                 continue;
 
-            if (wellTmp.getStatus() == Well::Status::SHUT)
+            if (wellTmp.shut)
                 continue;
 
             // Only count wells under group control or the ru
@@ -826,7 +855,8 @@ namespace WellGroupHelpers
                            const Phase& injectionPhase,
                            const PhaseUsage& pu)
     {
-        if (schedule.hasWell(name, reportStepIdx)) {
+        const auto tree = wellState.groupTree(schedule, reportStepIdx);
+        if (tree->hasWell(name)) {
             return guideRate->get(name, target, getWellRateVector(wellState, pu, name));
         }
 
@@ -835,9 +865,10 @@ namespace WellGroupHelpers
         }
 
         double totalGuideRate = 0.0;
-        const Group& group = schedule.getGroup(name, reportStepIdx);
+        const auto& group = tree->group(tree->groupIndex(name));
 
-        for (const std::string& groupName : group.groups()) {
+        for (const int child : group.groups) {
+            const std::string& groupName = tree->group(child).name;
             const Group::InjectionCMode& currentGroupControl
                 = group_state.injection_control(groupName, injectionPhase);
             if (currentGroupControl == Group::InjectionCMode::FLD
@@ -847,13 +878,14 @@ namespace WellGroupHelpers
             }
         }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
+        for (const int child : group.wells) {
+            const auto& wellTmp = tree->well(child);
+            const std::string& wellName = wellTmp.name;
 
-            if (!wellTmp.isInjector())
+            if (!wellTmp.injector)
                 continue;
 
-            if (wellTmp.getStatus() == Well::Status::SHUT)
+            if (wellTmp.shut)
                 continue;
 
             // Only count wells under group control or the ru
@@ -876,36 +908,9 @@ namespace WellGroupHelpers
                              const bool is_production_group,
                              const Phase injection_phase)
     {
-        const Group& group = schedule.getGroup(group_name, report_step);
-        int num_wells = 0;
-        for (const std::string& child_group : group.groups()) {
-
-            bool included = (child_group == always_included_child);
-            if (is_production_group) {
-                const auto ctrl = group_state.production_control(child_group);
-                included = included || (ctrl == Group::ProductionCMode::FLD) || (ctrl == Group::ProductionCMode::NONE);
-            } else {
-                const auto ctrl = group_state.injection_control(child_group, injection_phase);
-                included = included || (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
-            }
-
-            if (included) {
-                num_wells
-                    += groupControlledWells(schedule, well_state, group_state, report_step, child_group, always_included_child, is_production_group, injection_phase);
-            }
-        }
-        for (const std::string& child_well : group.wells()) {
-            bool included = (child_well == always_included_child);
-            if (is_production_group) {
-                included = included || well_state.isProductionGrup(child_well);
-            } else {
-                included = included || well_state.isInjectionGrup(child_well);
-            }
-            if (included) {
-                ++num_wells;
-            }
-        }
-        return num_wells;
+        const auto tree = well_state.groupTree(schedule, report_step);
+        return ::groupControlledWells(*tree, tree->groupIndex(group_name), well_state, group_state,
+                                      always_included_child, is_production_group, injection_phase);
     }
 
     FractionCalculator::FractionCalculator(const Schedule& schedule,
@@ -926,6 +931,9 @@ namespace WellGroupHelpers
         , pu_(pu)
         , is_producer_(is_producer)
         , injection_phase_(injection_phase)
+        , tree_(well_state.groupTree(schedule, report_step))
+        , num_controlled_wells_(tree_->numGroups(), -1)
+        , group_guide_rate_(tree_->numGroups())
     {
     }
     double FractionCalculator::fraction(const std::string& name,
@@ -942,25 +950,23 @@ namespace WellGroupHelpers
     }
     double FractionCalculator::localFraction(const std::string& name, const std::string& always_included_child)
     {
+        resetCache(always_included_child);
         const double my_guide_rate = guideRate(name, always_included_child);
-        const Group& parent_group = schedule_.getGroup(parent(name), report_step_);
-        const double total_guide_rate = guideRateSum(parent_group, always_included_child);
+        const double total_guide_rate = guideRateSum(tree_->groupIndex(parent(name)), always_included_child);
         assert(total_guide_rate >= my_guide_rate);
         const double guide_rate_epsilon = 1e-12;
         return (total_guide_rate > guide_rate_epsilon) ? my_guide_rate / total_guide_rate : 0.0;
     }
     std::string FractionCalculator::parent(const std::string& name)
     {
-        if (schedule_.hasWell(name)) {
-            return schedule_.getWell(name, report_step_).groupName();
-        } else {
-            return schedule_.getGroup(name, report_step_).parent();
-        }
+        return tree_->parent(name);
     }
-    double FractionCalculator::guideRateSum(const Group& group, const std::string& always_included_child)
+    double FractionCalculator::guideRateSum(const int group_index, const std::string& always_included_child)
     {
+        const auto& group = tree_->group(group_index);
         double total_guide_rate = 0.0;
-        for (const std::string& child_group : group.groups()) {
+        for (const int child : group.groups) {
+            const std::string& child_group = tree_->group(child).name;
             bool included = (child_group == always_included_child);
             if (is_producer_) {
                 const auto ctrl = this->group_state_.production_control(child_group);
@@ -970,10 +976,11 @@ namespace WellGroupHelpers
                 included = included || (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
             }
             if (included) {
-                total_guide_rate += guideRate(child_group, always_included_child);
+                total_guide_rate += groupGuideRate(child, always_included_child);
             }
         }
-        for (const std::string& child_well : group.wells()) {
+        for (const int child : group.wells) {
+            const std::string& child_well = tree_->well(child).name;
             bool included = (child_well == always_included_child);
             if (is_producer_) {
                 included = included || well_state_.isProductionGrup(child_well);
@@ -989,31 +996,82 @@ namespace WellGroupHelpers
     }
     double FractionCalculator::guideRate(const std::string& name, const std::string& always_included_child)
     {
-        if (schedule_.hasWell(name, report_step_)) {
+        if (tree_->hasWell(name)) {
             return guide_rate_->get(name, target_, getWellRateVector(well_state_, pu_, name));
         } else {
-            if (groupControlledWells(name, always_included_child) > 0) {
-                if (is_producer_ && guide_rate_->has(name)) {
-                    return guide_rate_->get(name, target_, getGroupRateVector(name));
-                } else if (!is_producer_ && guide_rate_->has(name, injection_phase_)) {
-                    return guide_rate_->get(name, injection_phase_);
-                } else {
-                    // We are a group, with default guide rate.
-                    // Compute guide rate by accumulating our children's guide rates.
-                    const Group& group = schedule_.getGroup(name, report_step_);
-                    return guideRateSum(group, always_included_child);
-                }
+            return groupGuideRate(tree_->groupIndex(name), always_included_child);
+        }
+    }
+    double FractionCalculator::groupGuideRate(const int group_index, const std::string& always_included_child)
+    {
+        auto& guide_rate = group_guide_rate_[group_index];
+        if (guide_rate.has_value())
+            return *guide_rate;
+
+        const std::string& name = tree_->group(group_index).name;
+        if (groupControlledWells(group_index, always_included_child) > 0) {
+            if (is_producer_ && guide_rate_->has(name)) {
+                guide_rate = guide_rate_->get(name, target_, getGroupRateVector(name));
+            } else if (!is_producer_ && guide_rate_->has(name, injection_phase_)) {
+                guide_rate = guide_rate_->get(name, injection_phase_);
             } else {
-                // No group-controlled subordinate wells.
-                return 0.0;
+                // We are a group, with default guide rate.
+                // Compute guide rate by accumulating our children's guide rates.
+                guide_rate = guideRateSum(group_index, always_included_child);
             }
+        } else {
+            // No group-controlled subordinate wells.
+            guide_rate = 0.0;
         }
+        return *guide_rate;
     }
-    int FractionCalculator::groupControlledWells(const std::string& group_name,
+    int FractionCalculator::groupControlledWells(const int group_index,
                                                  const std::string& always_included_child)
     {
-        return ::Opm::WellGroupHelpers::groupControlledWells(
-                                                             schedule_, well_state_, this->group_state_, report_step_, group_name, always_included_child, is_producer_, injection_phase_);
+        int& num_wells = num_controlled_wells_[group_index];
+        if (num_wells >= 0)
+            return num_wells;
+
+        const auto& group = tree_->group(group_index);
+        int count = 0;
+        for (const int child : group.groups) {
+            const std::string& child_group = tree_->group(child).name;
+            bool included = (child_group == always_included_child);
+            if (is_producer_) {
+                const auto ctrl = this->group_state_.production_control(child_group);
+                included = included || (ctrl == Group::ProductionCMode::FLD) || (ctrl == Group::ProductionCMode::NONE);
+            } else {
+                const auto ctrl = this->group_state_.injection_control(child_group, this->injection_phase_);
+                included = included || (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
+            }
+            if (included) {
+                count += groupControlledWells(child, always_included_child);
+            }
+        }
+        for (const int child : group.wells) {
+            const std::string& child_well = tree_->well(child).name;
+            bool included = (child_well == always_included_child);
+            if (is_producer_) {
+                included = included || well_state_.isProductionGrup(child_well);
+            } else {
+                included = included || well_state_.isInjectionGrup(child_well);
+            }
+            if (included) {
+                ++count;
+            }
+        }
+        num_wells = count;
+        return num_wells;
+    }
+    void FractionCalculator::resetCache(const std::string& always_included_child)
+    {
+        // The cached subtree results depend on the always included child.
+        if (always_included_child == cached_child_)
+            return;
+
+        cached_child_ = always_included_child;
+        std::fill(num_controlled_wells_.begin(), num_controlled_wells_.end(), -1);
+        std::fill(group_guide_rate_.begin(), group_guide_rate_.end(), std::nullopt);
     }
 
     GuideRate::RateVector FractionCalculator::getGroupRateVector(const std::string& group_name)
@@ -1131,7 +1189,7 @@ namespace WellGroupHelpers
         // TODO finish explanation.
         const double current_rate
             = -tcalc.calcModeRateFromRates(rates); // Switch sign since 'rates' are negative for producers.
-        const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx);
+        const auto chain = wellState.groupTree(schedule, reportStepIdx)->chainTopBot(name, group.name());
         // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
         const size_t num_ancestors = chain.size() - 1;
         // we need to find out the level where the current well is applied to the local reduction 
@@ -1258,7 +1316,7 @@ namespace WellGroupHelpers
         // TODO finish explanation.
         const double current_rate
             = tcalc.calcModeRateFromRates(rates); // Switch sign since 'rates' are negative for producers.
-        const auto chain = groupChainTopBot(name, group.name(), schedule, reportStepIdx);
+        const auto chain = wellState.groupTree(schedule, reportStepIdx)->chainTopBot(name, group.name());
         // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
         const size_t num_ancestors = chain.size() - 1;
         // we need to find out the level where the current well is applied to the local reduction
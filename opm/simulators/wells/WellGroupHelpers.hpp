@@ -24,6 +24,8 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Group/GuideRate.hpp>
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -33,15 +35,14 @@ namespace Opm
 class DeferredLogger;
 class Group;
 class GroupState;
+class GroupTree;
 namespace Network { class ExtNetwork; }
 struct PhaseUsage;
 class Schedule;
 class VFPProdProperties;
+class WellPhaseContainer;
 class WellState;
 
-template <typename>
-class WellContainer;
-
 namespace Network { class ExtNetwork; }
 
 namespace WellGroupHelpers
@@ -61,7 +62,7 @@ namespace WellGroupHelpers
                                          const int reportStepIdx,
                                          double& factor);
 
-    double sumWellPhaseRates(const WellContainer<std::vector<double>>& rates,
+    double sumWellPhaseRates(const WellPhaseContainer& rates,
                              const Group& group,
                              const Schedule& schedule,
                              const WellState& wellState,
@@ -250,9 +251,11 @@ namespace WellGroupHelpers
 
     private:
         std::string parent(const std::string& name);
-        double guideRateSum(const Group& group, const std::string& always_included_child);
+        double guideRateSum(const int group_index, const std::string& always_included_child);
         double guideRate(const std::string& name, const std::string& always_included_child);
-        int groupControlledWells(const std::string& group_name, const std::string& always_included_child);
+        double groupGuideRate(const int group_index, const std::string& always_included_child);
+        int groupControlledWells(const int group_index, const std::string& always_included_child);
+        void resetCache(const std::string& always_included_child);
         GuideRate::RateVector getGroupRateVector(const std::string& group_name);
         const Schedule& schedule_;
         const WellState& well_state_;
@@ -263,6 +266,12 @@ namespace WellGroupHelpers
         const PhaseUsage& pu_;
         bool is_producer_;
         Phase injection_phase_;
+        std::shared_ptr<const GroupTree> tree_;
+        // Number of group controlled wells and guide rate of the groups,
+        // by group index, for cached_child_ as the always included child.
+        std::string cached_child_;
+        std::vector<int> num_controlled_wells_;
+        std::vector<std::optional<double>> group_guide_rate_;
     };
 
 
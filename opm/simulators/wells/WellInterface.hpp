@@ -228,6 +228,14 @@ public:
 
     void addCellRates(RateVector& rates, int cellIdx) const;
 
+    /// Add the rates of a single perforation.
+    void addPerforationRates(RateVector& rates, int perfIdx) const
+    {
+        for (int i = 0; i < RateVector::dimension; ++i) {
+            rates[i] += connectionRates_[perfIdx][i];
+        }
+    }
+
     Scalar volumetricSurfaceRateForConnection(int cellIdx, int phaseIdx) const;
 
     template <class EvalWell>
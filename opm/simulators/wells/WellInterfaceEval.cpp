@@ -152,7 +152,7 @@ getGroupInjectionControl(const Group& group,
     };
 
     const double orig_target = tcalc.groupTarget(group.injectionControls(injectionPhase, summaryState), deferred_logger);
-    const auto chain = WellGroupHelpers::groupChainTopBot(baseif_.name(), group.name(), schedule, baseif_.currentStep());
+    const auto chain = well_state.groupTree(schedule, baseif_.currentStep())->chainTopBot(baseif_.name(), group.name());
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const size_t num_ancestors = chain.size() - 1;
     double target = orig_target;
@@ -246,7 +246,7 @@ getGroupProductionControl(const Group& group,
     };
 
     const double orig_target = tcalc.groupTarget(group.productionControls(summaryState));
-    const auto chain = WellGroupHelpers::groupChainTopBot(baseif_.name(), group.name(), schedule, baseif_.currentStep());
+    const auto chain = well_state.groupTree(schedule, baseif_.currentStep())->chainTopBot(baseif_.name(), group.name());
     // Because 'name' is the last of the elements, and not an ancestor, we subtract one below.
     const size_t num_ancestors = chain.size() - 1;
     double target = orig_target;
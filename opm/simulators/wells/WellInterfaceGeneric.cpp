@@ -29,9 +29,11 @@
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/VFPProperties.hpp>
 #include <opm/simulators/wells/WellState.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 #include <stdexcept>
 
 namespace Opm
@@ -83,6 +85,12 @@ WellInterfaceGeneric::WellInterfaceGeneric(const Well& well,
             saturation_table_number_[perf] = pd.satnum_id;
             ++perf;
         }
+
+        cell_perforations_.reserve(number_of_perforations_);
+        for (perf = 0; perf < number_of_perforations_; ++perf) {
+            cell_perforations_.emplace_back(well_cells_[perf], perf);
+        }
+        std::sort(cell_perforations_.begin(), cell_perforations_.end());
     }
 
     // initialization of the completions mapping
@@ -305,6 +313,18 @@ void WellInterfaceGeneric::setDynamicThpLimit(const double thp_limit)
     dynamic_thp_limit_ = thp_limit;
 }
 
+std::pair<WellInterfaceGeneric::CellPerforationIterator,
+          WellInterfaceGeneric::CellPerforationIterator>
+WellInterfaceGeneric::perforationsInCell(int cellIdx) const
+{
+    constexpr int minPerf = std::numeric_limits<int>::min();
+    const auto first = std::lower_bound(cell_perforations_.begin(), cell_perforations_.end(),
+                                        std::make_pair(cellIdx, minPerf));
+    const auto last = std::lower_bound(first, cell_perforations_.end(),
+                                       std::make_pair(cellIdx + 1, minPerf));
+    return {first, last};
+}
+
 void WellInterfaceGeneric::updatePerforatedCell(std::vector<bool>& is_cell_perforated)
 {
 
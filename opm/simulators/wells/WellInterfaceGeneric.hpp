@@ -29,6 +29,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -71,6 +72,12 @@ public:
     /// Well cells.
     const std::vector<int>& cells() const { return well_cells_; }
 
+    using CellPerforationIterator = std::vector<std::pair<int,int>>::const_iterator;
+
+    /// Perforations of the well in a cell, as a range of (cell, perforation) pairs.
+    std::pair<CellPerforationIterator, CellPerforationIterator>
+    perforationsInCell(int cellIdx) const;
+
     /// Index of well in the wells struct and wellState
     int indexOfWell() const;
 
@@ -250,6 +257,9 @@ protected:
     // cell index for each well perforation
     std::vector<int> well_cells_;
 
+    // (cell index, perforation index) pairs sorted by cell index
+    std::vector<std::pair<int,int>> cell_perforations_;
+
     // well index for each perforation
     std::vector<double> well_index_;
 
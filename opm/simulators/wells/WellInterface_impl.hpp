@@ -420,23 +420,19 @@ namespace Opm
     void
     WellInterface<TypeTag>::addCellRates(RateVector& rates, int cellIdx) const
     {
-        for (int perfIdx = 0; perfIdx < this->number_of_perforations_; ++perfIdx) {
-            if (this->cells()[perfIdx] == cellIdx) {
-                for (int i = 0; i < RateVector::dimension; ++i) {
-                    rates[i] += connectionRates_[perfIdx][i];
-                }
-            }
+        const auto [first, last] = this->perforationsInCell(cellIdx);
+        for (auto perf = first; perf != last; ++perf) {
+            addPerforationRates(rates, perf->second);
         }
     }
 
     template<typename TypeTag>
     typename WellInterface<TypeTag>::Scalar
     WellInterface<TypeTag>::volumetricSurfaceRateForConnection(int cellIdx, int phaseIdx) const {
-        for (int perfIdx = 0; perfIdx < this->number_of_perforations_; ++perfIdx) {
-            if (this->cells()[perfIdx] == cellIdx) {
-                const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
-                return connectionRates_[perfIdx][activeCompIdx].value();
-            }
+        const auto [first, last] = this->perforationsInCell(cellIdx);
+        if (first != last) {
+            const unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
+            return connectionRates_[first->second][activeCompIdx].value();
         }
         // this is not thread safe
         OPM_THROW(std::invalid_argument, "The well with name " + this->name()
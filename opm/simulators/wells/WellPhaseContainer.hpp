@@ -0,0 +1,176 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELL_PHASE_CONTAINER_HEADER_INCLUDED
+#define OPM_WELL_PHASE_CONTAINER_HEADER_INCLUDED
+
+#include <opm/simulators/wells/WellContainer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*
+  View of the values of one well in a WellPhaseContainer. The view does not
+  own the values, and is invalidated when wells are added to or removed from
+  the container it was taken from.
+*/
+template <class T>
+class WellPhaseView {
+public:
+    WellPhaseView(T* data, std::size_t size)
+        : m_data(data)
+        , m_size(size)
+    {}
+
+    template <class U>
+    WellPhaseView(const WellPhaseView<U>& other)
+        : m_data(other.data())
+        , m_size(other.size())
+    {}
+
+    T& operator[](std::size_t phase) const {
+        return this->m_data[phase];
+    }
+
+    T* data() const {
+        return this->m_data;
+    }
+
+    std::size_t size() const {
+        return this->m_size;
+    }
+
+    T* begin() const {
+        return this->m_data;
+    }
+
+    T* end() const {
+        return this->m_data + this->m_size;
+    }
+
+private:
+    T* m_data;
+    std::size_t m_size;
+};
+
+
+/*
+  The WellPhaseContainer class holds one value per phase for a set of wells,
+  like the surface rates or the potentials of the wells. It has the same
+  name and index based access as WellContainer<std::vector<double>>, but
+  the values of all wells are stored in a single array, with the values of
+  well i at offset(i). Copying the container, which happens every time the
+  well state is copied, is a copy of that array instead of one allocation
+  per well.
+*/
+class WellPhaseContainer {
+public:
+    using View = WellPhaseView<double>;
+    using ConstView = WellPhaseView<const double>;
+
+    WellPhaseContainer() = default;
+
+    bool empty() const {
+        return this->m_offset.empty();
+    }
+
+    std::size_t size() const {
+        return this->m_offset.size();
+    }
+
+    std::size_t numPhases() const {
+        return this->m_num_phases;
+    }
+
+    void add(const std::string& name, const std::vector<double>& values) {
+        if (this->empty())
+            this->m_num_phases = values.size();
+        else if (values.size() != this->m_num_phases)
+            throw std::logic_error("Well " + name + " has a different number of phases than the container");
+
+        this->m_offset.add(name, this->m_data.size());
+        this->m_data.insert(this->m_data.end(), values.begin(), values.end());
+    }
+
+    bool has(const std::string& name) const {
+        return this->m_offset.has(name);
+    }
+
+    std::optional<int> well_index(const std::string& wname) const {
+        return this->m_offset.well_index(wname);
+    }
+
+    std::size_t offset(std::size_t index) const {
+        return this->m_offset[index];
+    }
+
+    /*
+      Will copy the values for well @name from other to this. The well @name
+      must exist in both containers, otherwise an exception is thrown.
+    */
+    void copy_welldata(const WellPhaseContainer& other, const std::string& name) {
+        const auto src = other[name];
+        std::copy(src.begin(), src.end(), (*this)[name].begin());
+    }
+
+    View operator[](std::size_t index) {
+        return { this->m_data.data() + this->m_offset[index], this->m_num_phases };
+    }
+
+    ConstView operator[](std::size_t index) const {
+        return { this->m_data.data() + this->m_offset[index], this->m_num_phases };
+    }
+
+    View operator[](const std::string& name) {
+        return { this->m_data.data() + this->m_offset[name], this->m_num_phases };
+    }
+
+    ConstView operator[](const std::string& name) const {
+        return { this->m_data.data() + this->m_offset[name], this->m_num_phases };
+    }
+
+    void clear() {
+        this->m_data.clear();
+        this->m_offset.clear();
+        this->m_num_phases = 0;
+    }
+
+    /*
+      The values of all wells, well by well.
+    */
+    const std::vector<double>& data() const {
+        return this->m_data;
+    }
+
+private:
+    std::vector<double> m_data;
+    WellContainer<std::size_t> m_offset;
+    std::size_t m_num_phases = 0;
+};
+
+}
+
+
+#endif
@@ -158,7 +158,7 @@ void WellState::initSingleWell(const std::vector<double>& cellPressures,
         //    (producer) or RATE (injector).
         //    Otherwise, we cannot set the correct
         //    value here and initialize to zero rate.
-        auto& rates = this->wellrates_[w];
+        auto rates = this->wellrates_[w];
         if (well.isInjector()) {
             if (inj_controls.cmode == Well::InjectorCMode::RATE) {
                 switch (inj_controls.injector_type) {
@@ -239,9 +239,11 @@ void WellState::init(const std::vector<double>& cellPressures,
     // call init on base class
     this->base_init(cellPressures, wells_ecl, parallel_well_info, well_perf_data, summary_state);
     this->global_well_info = std::make_optional<GlobalWellInfo>( schedule, report_step, wells_ecl );
+    this->group_tree_ = std::make_shared<const GroupTree>(schedule, report_step);
     for (const auto& wname : schedule.wellNames(report_step))
     {
-        well_rates.insert({wname, std::make_pair(false, std::vector<double>(this->numPhases()))});
+        if (!well_rates.has(wname))
+            well_rates.add(wname, std::make_pair(false, std::vector<double>(this->numPhases())));
     }
     for (const auto& winfo: parallel_well_info)
     {
@@ -379,13 +381,11 @@ void WellState::init(const std::vector<double>& cellPressures,
                     current_production_controls_[ newIndex ] = prevState->currentProductionControl(oldIndex);
                 }
 
-                wellRates(w) = prevState->wellRates(oldIndex);
-                wellReservoirRates(w) = prevState->wellReservoirRates(oldIndex);
+                this->wellrates_.copy_welldata(prevState->wellrates_, wname);
+                this->well_reservoir_rates_.copy_welldata(prevState->well_reservoir_rates_, wname);
 
                 // Well potentials
-                for (int p=0; p < np; p++) {
-                    this->wellPotentials(newIndex)[p] = prevState->wellPotentials(oldIndex)[p];
-                }
+                this->well_potentials_.copy_welldata(prevState->well_potentials_, wname);
 
                 // perfPhaseRates
                 const int num_perf_old_well = (*it).second[ 2 ];
@@ -460,12 +460,12 @@ void WellState::resize(const std::vector<Well>& wells_ecl,
 const std::vector<double>&
 WellState::currentWellRates(const std::string& wellName) const
 {
-    auto it = well_rates.find(wellName);
+    const auto index = well_rates.well_index(wellName);
 
-    if (it == well_rates.end())
+    if (!index)
         OPM_THROW(std::logic_error, "Could not find any rates for well  " << wellName);
 
-    return it->second.second;
+    return well_rates[*index].second;
 }
 
 template<class Communication>
@@ -849,12 +849,12 @@ void WellState::shutWell(int well_index)
     this->thp_[well_index] = 0;
     this->bhp_[well_index] = 0;
     const int np = numPhases();
-    this->wellrates_[well_index].assign(np, 0);
-
-    auto& resv = this->well_reservoir_rates_[well_index];
-    auto& wpi  = this->productivity_index_[well_index];
+    auto rates = this->wellrates_[well_index];
+    auto resv = this->well_reservoir_rates_[well_index];
+    auto wpi  = this->productivity_index_[well_index];
 
     for (int p = 0; p < np; ++p) {
+        rates[p] = 0.0;
         resv[p] = 0.0;
         wpi[p]  = 0.0;
     }
@@ -888,10 +888,8 @@ void WellState::communicateGroupRates(const Comm& comm)
 {
     // Compute the size of the data.
     std::size_t sz = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
+    for (const auto& [_, rates] : this->well_rates) {
         (void)_;
-        const auto& [__, rates] = owner_rates;
-        (void)__;
         sz += rates.size();
     }
     sz += this->alq_state.pack_size();
@@ -900,9 +898,7 @@ void WellState::communicateGroupRates(const Comm& comm)
     // Make a vector and collect all data into it.
     std::vector<double> data(sz);
     std::size_t pos = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        const auto& [owner, rates] = owner_rates;
+    for (const auto& [owner, rates] : this->well_rates) {
         for (const auto& value : rates) {
             if (owner)
                 data[pos++] = value;
@@ -917,11 +913,8 @@ void WellState::communicateGroupRates(const Comm& comm)
     comm.sum(data.data(), data.size());
 
     pos = 0;
-    for (auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        auto& [__, rates] = owner_rates;
-        (void)__;
-        for (auto& value : rates)
+    for (std::size_t w = 0; w < this->well_rates.size(); ++w) {
+        for (auto& value : this->well_rates[w].second)
             value = data[pos++];
     }
     pos += this->alq_state.unpack_data(&data[pos]);
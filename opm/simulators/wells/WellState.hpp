@@ -23,8 +23,10 @@
 
 #include <opm/simulators/wells/ALQState.hpp>
 #include <opm/simulators/wells/GlobalWellInfo.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/SegmentState.hpp>
 #include <opm/simulators/wells/WellContainer.hpp>
+#include <opm/simulators/wells/WellPhaseContainer.hpp>
 #include <opm/core/props/BlackoilPhases.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
 #include <opm/simulators/wells/PerfData.hpp>
@@ -35,8 +37,10 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -52,7 +56,7 @@ class WellState
 {
 public:
     using mapentry_t = std::array<int, 3>;
-    using WellMapType = std::map<std::string, mapentry_t>;
+    using WellMapType = std::unordered_map<std::string, mapentry_t>;
 
     static const uint64_t event_mask = ScheduleEvents::WELL_STATUS_CHANGE + ScheduleEvents::PRODUCTION_UPDATE + ScheduleEvents::INJECTION_UPDATE;
 
@@ -111,7 +115,7 @@ public:
     void currentProductionControl(std::size_t well_index, Well::ProducerCMode cmode) { current_production_controls_[well_index] = cmode; }
 
     void setCurrentWellRates(const std::string& wellName, const std::vector<double>& new_rates ) {
-        auto& [owner, rates] = this->well_rates.at(wellName);
+        auto& [owner, rates] = this->well_rates[wellName];
         if (owner)
             rates = new_rates;
     }
@@ -119,7 +123,7 @@ public:
     const std::vector<double>& currentWellRates(const std::string& wellName) const;
 
     bool hasWellRates(const std::string& wellName) const {
-        return this->well_rates.find(wellName) != this->well_rates.end();
+        return this->well_rates.has(wellName);
     }
 
     template<class Communication>
@@ -155,14 +159,14 @@ public:
     /// One rate pr well
     double brineWellRate(const int w) const;
 
-    const WellContainer<std::vector<double>>& wellReservoirRates() const { return well_reservoir_rates_; }
+    const WellPhaseContainer& wellReservoirRates() const { return well_reservoir_rates_; }
 
-    std::vector<double>& wellReservoirRates(std::size_t well_index)
+    WellPhaseContainer::View wellReservoirRates(std::size_t well_index)
     {
         return well_reservoir_rates_[well_index];
     }
 
-    const std::vector<double>& wellReservoirRates(std::size_t well_index) const
+    WellPhaseContainer::ConstView wellReservoirRates(std::size_t well_index) const
     {
         return well_reservoir_rates_[well_index];
     }
@@ -196,19 +200,19 @@ public:
         return this->segment_state[wname];
     }
 
-    std::vector<double>& productivityIndex(std::size_t well_index) {
+    WellPhaseContainer::View productivityIndex(std::size_t well_index) {
         return this->productivity_index_[well_index];
     }
 
-    const std::vector<double>& productivityIndex(std::size_t well_index) const {
+    WellPhaseContainer::ConstView productivityIndex(std::size_t well_index) const {
         return this->productivity_index_[well_index];
     }
 
-    std::vector<double>& wellPotentials(std::size_t well_index) {
+    WellPhaseContainer::View wellPotentials(std::size_t well_index) {
         return this->well_potentials_[well_index];
     }
 
-    const std::vector<double>& wellPotentials(std::size_t well_index) const {
+    WellPhaseContainer::ConstView wellPotentials(std::size_t well_index) const {
         return this->well_potentials_[well_index];
     }
 
@@ -226,6 +230,37 @@ public:
         return this->global_well_info.value().in_producing_group(name);
     }
 
+    /// The group tree of report step @report_step. The tree compiled by
+    /// init() is shared by all copies of the well state; for any other
+    /// report step a tree is built from @schedule and kept until the next
+    /// request of yet another report step. The cache is accessed atomically
+    /// since the wells call this concurrently, e.g. when computing their
+    /// potentials.
+    std::shared_ptr<const GroupTree> groupTree(const Schedule& schedule, const int report_step) const
+    {
+        if (this->group_tree_ && this->group_tree_->reportStep() == report_step)
+            return this->group_tree_;
+
+        auto tree = std::atomic_load(&this->other_group_tree_);
+        if (!tree || tree->reportStep() != report_step) {
+            tree = std::make_shared<const GroupTree>(schedule, report_step);
+            std::atomic_store(&this->other_group_tree_, tree);
+        }
+
+        return tree;
+    }
+
+    /// Rebuild the group tree from @schedule, after the status or the
+    /// efficiency factors of its wells or groups have been changed, e.g.
+    /// by an action.
+    void updateGroupTree(const Schedule& schedule)
+    {
+        if (this->group_tree_)
+            this->group_tree_ = std::make_shared<const GroupTree>(schedule, this->group_tree_->reportStep());
+
+        this->other_group_tree_.reset();
+    }
+
     double getALQ( const std::string& name) const
     {
         return this->alq_state.get(name);
@@ -317,9 +352,9 @@ public:
     double temperature(std::size_t well_index) const { return temperature_[well_index]; }
 
     /// One rate per well and phase.
-    const WellContainer<std::vector<double>>& wellRates() const { return wellrates_; }
-    std::vector<double>& wellRates(std::size_t well_index) { return wellrates_[well_index]; }
-    const std::vector<double>& wellRates(std::size_t well_index) const { return wellrates_[well_index]; }
+    const WellPhaseContainer& wellRates() const { return wellrates_; }
+    WellPhaseContainer::View wellRates(std::size_t well_index) { return wellrates_[well_index]; }
+    WellPhaseContainer::ConstView wellRates(std::size_t well_index) const { return wellrates_[well_index]; }
 
     std::size_t numPerf(std::size_t well_index) const { return this->perfdata[well_index].size(); }
 
@@ -345,6 +380,8 @@ private:
     // WellStateFullyImplicitBlackoil class should be default constructible,
     // whereas the GlobalWellInfo is not.
     std::optional<GlobalWellInfo> global_well_info;
+    std::shared_ptr<const GroupTree> group_tree_;
+    mutable std::shared_ptr<const GroupTree> other_group_tree_;
     ALQState alq_state;
     bool do_glift_optimization_;
 
@@ -354,7 +391,7 @@ private:
     WellContainer<double> bhp_;
     WellContainer<double> thp_;
     WellContainer<double> temperature_;
-    WellContainer<std::vector<double>> wellrates_;
+    WellPhaseContainer wellrates_;
     PhaseUsage phase_usage_;
     WellContainer<PerfData> perfdata;
 
@@ -368,12 +405,12 @@ private:
 
     // The well_rates variable is defined for all wells on all processors. The
     // bool in the value pair is whether the current process owns the well or
-    // not.
-    std::map<std::string, std::pair<bool, std::vector<double>>> well_rates;
+    // not. The wells are stored in the same order on all processors.
+    WellContainer<std::pair<bool, std::vector<double>>> well_rates;
 
     // phase rates under reservoir condition for wells
     // or voidage phase rates
-    WellContainer<std::vector<double>> well_reservoir_rates_;
+    WellPhaseContainer well_reservoir_rates_;
 
     // dissolved gas rates or solution gas production rates
     // should be zero for injection wells
@@ -391,10 +428,10 @@ private:
     WellContainer<SegmentState> segment_state;
 
     // Productivity Index
-    WellContainer<std::vector<double>> productivity_index_;
+    WellPhaseContainer productivity_index_;
 
     // Well potentials
-    WellContainer<std::vector<double>> well_potentials_;
+    WellPhaseContainer well_potentials_;
 
 
     data::Segment
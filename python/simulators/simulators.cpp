@@ -25,14 +25,18 @@
 #define FLOW_BLACKOIL_ONLY
 #include <opm/simulators/flow/Main.hpp>
 #include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/flow/python/PyFluidState.hpp>
 #include <opm/simulators/flow/python/PyMaterialState.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/embed.h>
+#include <pybind11/stl.h>
 // NOTE: EXIT_SUCCESS, EXIT_FAILURE is defined in cstdlib
 #include <cstdlib>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <opm/simulators/flow/python/simulators.hpp>
 
 namespace py = pybind11;
@@ -43,11 +47,100 @@ BlackOilSimulator::BlackOilSimulator( const std::string &deckFilename)
 {
 }
 
+int BlackOilSimulator::checkpoint()
+{
+    checkStepping_("checkpoint()");
+    const int handle = nextCheckpoint_++;
+    checkpoints_.emplace(handle,
+        Checkpoint{SimulatorCheckpoint<TypeTag>(*ebosSimulator_),
+                   *mainEbos_->getSimulatorTimerPtr(),
+                   mainEbos_->getFlowSimulatorPtr()->suggestedNextStep()});
+    return handle;
+}
+
+void BlackOilSimulator::checkStepping_(const std::string& method) const
+{
+    if (!hasRunInit_) {
+        throw std::logic_error(method + " called before step_init()");
+    }
+    if (hasRunCleanup_) {
+        throw std::logic_error(method + " called after step_cleanup()");
+    }
+}
+
+const PyFluidState<TypeTag>& BlackOilSimulator::currentFluidState_()
+{
+    // The buffers are filled on first use and refreshed after every
+    // step() and restore() from then on.
+    if (fluidState_->numCells() == 0) {
+        fluidState_->update();
+    }
+    return *fluidState_;
+}
+
+void BlackOilSimulator::discardCheckpoint(int handle)
+{
+    checkpoints_.erase(handle);
+}
+
 py::array_t<double> BlackOilSimulator::getPorosity()
 {
-    std::size_t len;
-    auto array = materialState_->getPorosity(&len);
-    return py::array(len, array.get());
+    const auto& poro = materialState_->getPorosity();
+    return view_(poro, {static_cast<py::ssize_t>(poro.size())});
+}
+
+py::array_t<double> BlackOilSimulator::getPressure()
+{
+    const auto& fs = currentFluidState_();
+    return view_(fs.pressure(), {static_cast<py::ssize_t>(fs.numCells())});
+}
+
+py::array_t<double> BlackOilSimulator::getRs()
+{
+    const auto& fs = currentFluidState_();
+    return view_(fs.rs(), {static_cast<py::ssize_t>(fs.numCells())});
+}
+
+py::array_t<double> BlackOilSimulator::getRv()
+{
+    const auto& fs = currentFluidState_();
+    return view_(fs.rv(), {static_cast<py::ssize_t>(fs.numCells())});
+}
+
+py::array_t<double> BlackOilSimulator::getSaturation()
+{
+    const auto& fs = currentFluidState_();
+    return view_(fs.saturation(), {static_cast<py::ssize_t>(fs.numPhases),
+                                   static_cast<py::ssize_t>(fs.numCells())});
+}
+
+std::vector<std::string> BlackOilSimulator::getWellNames()
+{
+    return currentFluidState_().wellNames();
+}
+
+py::array_t<double> BlackOilSimulator::getWellRates()
+{
+    const auto& fs = currentFluidState_();
+    return view_(fs.wellRates(), {static_cast<py::ssize_t>(fs.numWells()),
+                                  static_cast<py::ssize_t>(fs.numWellPhases())});
+}
+
+void BlackOilSimulator::restore(int handle)
+{
+    checkStepping_("restore()");
+    auto it = checkpoints_.find(handle);
+    if (it == checkpoints_.end()) {
+        throw std::invalid_argument("restore(): unknown checkpoint "
+                                    + std::to_string(handle));
+    }
+    const auto& cp = it->second;
+    cp.state.restore(*ebosSimulator_);
+    *mainEbos_->getSimulatorTimerPtr() = cp.timer;
+    mainEbos_->getFlowSimulatorPtr()->setSuggestedNextStep(cp.suggestedNextStep);
+    if (fluidState_->numCells() > 0) {
+        fluidState_->update();
+    }
 }
 
 int BlackOilSimulator::run()
@@ -56,6 +149,12 @@ int BlackOilSimulator::run()
     return mainObject.runDynamic();
 }
 
+void BlackOilSimulator::setPermeabilityMultipliers( py::array_t<double,
+    py::array::c_style | py::array::forcecast> array)
+{
+    materialState_->setPermeabilityMultipliers(array.data(), array.size());
+}
+
 void BlackOilSimulator::setPorosity( py::array_t<double,
     py::array::c_style | py::array::forcecast> array)
 {
@@ -64,15 +163,44 @@ void BlackOilSimulator::setPorosity( py::array_t<double,
     materialState_->setPorosity(poro, size_);
 }
 
-int BlackOilSimulator::step()
+void BlackOilSimulator::setWellStatus(const std::vector<std::string>& names,
+                                      const std::vector<bool>& open)
 {
-    if (!hasRunInit_) {
-        throw std::logic_error("step() called before step_init()");
+    checkStepping_("set_well_status()");
+    if (names.size() != open.size()) {
+        throw std::invalid_argument("set_well_status(): got "
+                                    + std::to_string(names.size()) + " wells and "
+                                    + std::to_string(open.size()) + " status values");
     }
-    if (hasRunCleanup_) {
-        throw std::logic_error("step() called after step_cleanup()");
+
+    // Change the status from the report step run by the next step(), in
+    // the same way as a WELOPEN in an ACTIONX block.
+    auto& schedule = ebosSimulator_->vanguard().schedule();
+    const int reportStep = mainEbos_->getSimulatorTimerPtr()->currentStepNum();
+    std::unordered_set<std::string> wells;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (open[i]) {
+            schedule.open_well(names[i], reportStep);
+        }
+        else {
+            schedule.shut_well(names[i], reportStep);
+        }
+        wells.insert(names[i]);
     }
-    return mainEbos_->executeStep();
+
+    auto& wellModel = ebosSimulator_->problem().wellModel();
+    wellModel.updateEclWells(reportStep, wells);
+    wellModel.commitWGState();
+}
+
+int BlackOilSimulator::step()
+{
+    checkStepping_("step()");
+    int result = mainEbos_->executeStep();
+    if (fluidState_->numCells() > 0) {
+        fluidState_->update();
+    }
+    return result;
 }
 
 int BlackOilSimulator::stepCleanup()
@@ -102,6 +230,8 @@ int BlackOilSimulator::stepInit()
         ebosSimulator_ = mainEbos_->getSimulatorPtr();
         materialState_ = std::make_unique<PyMaterialState<TypeTag>>(
             ebosSimulator_);
+        fluidState_ = std::make_unique<PyFluidState<TypeTag>>(
+            ebosSimulator_);
         return result;
     }
     else {
@@ -109,6 +239,19 @@ int BlackOilSimulator::stepInit()
     }
 }
 
+py::array_t<double> BlackOilSimulator::view_(const std::vector<double>& data,
+                                             std::vector<py::ssize_t> shape)
+{
+    // The simulator object is the base of the array, so the buffer stays
+    // alive as long as the view. The views are read-only, values are
+    // changed with the set_*() methods.
+    py::array_t<double> array(std::move(shape), data.data(),
+                              py::cast(this, py::return_value_policy::reference));
+    py::detail::array_proxy(array.ptr())->flags &=
+        ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return array;
+}
+
 } // namespace Opm::Pybind
 
 PYBIND11_MODULE(simulators, m)
@@ -116,10 +259,20 @@ PYBIND11_MODULE(simulators, m)
     using namespace Opm::Pybind;
     py::class_<BlackOilSimulator>(m, "BlackOilSimulator")
         .def(py::init< const std::string& >())
-        .def("get_porosity", &BlackOilSimulator::getPorosity,
-            py::return_value_policy::copy)
+        .def("checkpoint", &BlackOilSimulator::checkpoint)
+        .def("discard_checkpoint", &BlackOilSimulator::discardCheckpoint)
+        .def("get_porosity", &BlackOilSimulator::getPorosity)
+        .def("get_pressure", &BlackOilSimulator::getPressure)
+        .def("get_rs", &BlackOilSimulator::getRs)
+        .def("get_rv", &BlackOilSimulator::getRv)
+        .def("get_saturation", &BlackOilSimulator::getSaturation)
+        .def("get_well_names", &BlackOilSimulator::getWellNames)
+        .def("get_well_rates", &BlackOilSimulator::getWellRates)
+        .def("restore", &BlackOilSimulator::restore)
         .def("run", &BlackOilSimulator::run)
+        .def("set_permeability_multipliers", &BlackOilSimulator::setPermeabilityMultipliers)
         .def("set_porosity", &BlackOilSimulator::setPorosity)
+        .def("set_well_status", &BlackOilSimulator::setWellStatus)
         .def("step", &BlackOilSimulator::step)
         .def("step_init", &BlackOilSimulator::stepInit)
         .def("step_cleanup", &BlackOilSimulator::stepCleanup);
@@ -73,3 +73,20 @@ class TestBasic(unittest.TestCase):
             poro2 = sim.get_porosity()
             self.assertAlmostEqual(poro2[0], 0.285, places=7, msg='value of porosity 2')
 
+            pressure = sim.get_pressure()
+            self.assertEqual(len(pressure), 300, 'length of pressure vector')
+            self.assertFalse(pressure.flags.writeable, 'pressure view is read-only')
+            self.assertEqual(sim.get_saturation().shape, (3, 300), 'shape of saturation')
+            self.assertEqual(sim.get_well_rates().shape[0], len(sim.get_well_names()),
+                             'one row of well rates per well')
+
+            handle = sim.checkpoint()
+            pressure_at_checkpoint = pressure.copy()
+            sim.step()
+            sim.restore(handle)
+            self.assertEqual(sim.get_pressure()[0], pressure_at_checkpoint[0], 'pressure after restore')
+            sim.step()
+            sim.discard_checkpoint(handle)
+            with self.assertRaises(ValueError):
+                sim.restore(handle)
+
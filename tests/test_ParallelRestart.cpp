@@ -676,6 +676,62 @@ TEST_FOR_TYPE(WellType)
 TEST_FOR_TYPE(WListManager)
 TEST_FOR_TYPE(WriteRestartFileEvents)
 
+namespace {
+
+struct BulkTestData
+{
+    std::vector<double> values;
+    std::vector<int> indices;
+    std::vector<bool> flags;
+    std::string name;
+    std::map<std::string, std::vector<double>> tables;
+    std::optional<double> opt;
+
+    static BulkTestData serializeObject()
+    {
+        BulkTestData result;
+        result.values.resize(100000);
+        for (std::size_t i = 0; i < result.values.size(); ++i)
+            result.values[i] = 0.5 * i;
+        result.indices = {1, 2, 3, 5, 8};
+        result.flags = {true, false, true};
+        result.name = "bulk";
+        result.tables = {{"A", {1.0, 2.0}}, {"B", {}}};
+        result.opt = 3.0;
+        return result;
+    }
+
+    bool operator==(const BulkTestData& rhs) const
+    {
+        return values == rhs.values &&
+               indices == rhs.indices &&
+               flags == rhs.flags &&
+               name == rhs.name &&
+               tables == rhs.tables &&
+               opt == rhs.opt;
+    }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(values);
+        serializer.template vector<int,false>(indices);
+        serializer(flags);
+        serializer(name);
+        serializer.template map<decltype(tables),false>(tables);
+        serializer(opt);
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(SerializerBulkData)
+{
+    auto val1 = BulkTestData::serializeObject();
+    auto val2 = PackUnpack2(val1);
+    DO_CHECKS(BulkData)
+}
+
 
 bool init_unit_test_func()
 {
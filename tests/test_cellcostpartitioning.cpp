@@ -0,0 +1,192 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE OPM_test_CellCostPartitioning
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/CellCostPartitioning.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A row of cells along the x axis.
+std::vector<std::array<double, 3>> rowOfCells(const int n)
+{
+    std::vector<std::array<double, 3>> centroids(n);
+    for (int i = 0; i < n; ++i) {
+        centroids[i] = {static_cast<double>(i), 0.0, 0.0};
+    }
+    return centroids;
+}
+
+std::vector<double> partCosts(const std::vector<int>& parts,
+                              const std::vector<double>& costs,
+                              const int numParts)
+{
+    std::vector<double> result(numParts, 0.0);
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        result[parts[i]] += costs[i];
+    }
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(UniformCosts)
+{
+    const int n = 12;
+    const std::vector<double> costs(n, 1.0);
+    const auto parts = Opm::partitionCellsByCost(rowOfCells(n), costs, {}, 3);
+    BOOST_REQUIRE_EQUAL(parts.size(), static_cast<std::size_t>(n));
+    for (const double cost : partCosts(parts, costs, 3)) {
+        BOOST_CHECK_EQUAL(cost, 4.0);
+    }
+    // The parts are contiguous along the row.
+    BOOST_CHECK(std::is_sorted(parts.begin(), parts.end()));
+}
+
+BOOST_AUTO_TEST_CASE(ExpensiveCells)
+{
+    const int n = 10;
+    std::vector<double> costs(n, 1.0);
+    costs[0] = 5.0;
+    const auto parts = Opm::partitionCellsByCost(rowOfCells(n), costs, {}, 2);
+    const auto cost = partCosts(parts, costs, 2);
+    BOOST_CHECK_EQUAL(cost[0], 7.0);
+    BOOST_CHECK_EQUAL(cost[1], 7.0);
+}
+
+BOOST_AUTO_TEST_CASE(WellCellsStayTogether)
+{
+    const int n = 8;
+    const std::vector<double> costs(n, 1.0);
+    const std::vector<std::vector<int>> wells{{2, 3, 4, 5}, {5, 6}};
+    const auto parts = Opm::partitionCellsByCost(rowOfCells(n), costs, wells, 2);
+    for (const int cell : {3, 4, 5, 6}) {
+        BOOST_CHECK_EQUAL(parts[cell], parts[2]);
+    }
+    BOOST_CHECK_NE(parts[0], parts[7]);
+}
+
+BOOST_AUTO_TEST_CASE(NoEmptyParts)
+{
+    // Fewer groups of cells than parts: the wells are split up.
+    const int n = 6;
+    const std::vector<double> costs(n, 1.0);
+    const std::vector<std::vector<int>> wells{{0, 1, 2}, {3, 4, 5}};
+    const auto parts = Opm::partitionCellsByCost(rowOfCells(n), costs, wells, 4);
+    for (const double cost : partCosts(parts, costs, 4)) {
+        BOOST_CHECK_GT(cost, 0.0);
+    }
+
+    // One expensive cell must not take the cells of the other parts.
+    std::vector<double> skewed(5, 1.0);
+    skewed[0] = 100.0;
+    const auto skewedParts = Opm::partitionCellsByCost(rowOfCells(5), skewed, {}, 5);
+    for (const double cost : partCosts(skewedParts, skewed, 5)) {
+        BOOST_CHECK_GT(cost, 0.0);
+    }
+
+    // Fewer cells than parts.
+    const auto fewParts = Opm::partitionCellsByCost(rowOfCells(2), {1.0, 1.0}, {}, 3);
+    BOOST_CHECK_NE(fewParts[0], fewParts[1]);
+}
+
+BOOST_AUTO_TEST_CASE(CostsOfFeatures)
+{
+    std::vector<Opm::CellCostFeatures> features(2);
+    features[1].connections = 4;
+    features[1].perforations = 1;
+    features[1].msPerforations = 1;
+    features[1].aquiferConnections = 2;
+    Opm::CellCostCoefficients coefficients;
+    coefficients.connection = 0.5;
+    coefficients.perforation = 2.0;
+    coefficients.msPerforation = 3.0;
+    coefficients.aquiferConnection = 0.25;
+    const auto costs = Opm::cellCosts(features, coefficients);
+    BOOST_CHECK_CLOSE(costs[0], 1.0, 1e-12);
+    BOOST_CHECK_CLOSE(costs[1], 1.0 + 2.0 + 2.0 + 3.0 + 0.5, 1e-12);
+
+    const auto statistics = Opm::cellCostStatistics(features, {false, true}, 3.0);
+    BOOST_CHECK_EQUAL(statistics.cells, 1.0);
+    BOOST_CHECK_EQUAL(statistics.connections, 4.0);
+    BOOST_CHECK_EQUAL(statistics.aquiferConnections, 2.0);
+    BOOST_CHECK_EQUAL(statistics.seconds, 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(Calibration)
+{
+    // Times generated by perforations that are ten times as expensive as
+    // in the prior.
+    const Opm::CellCostCoefficients prior;
+    Opm::CellCostCoefficients truth = prior;
+    truth.perforation = 40.0;
+    const double secondsPerCell = 1e-3;
+
+    std::vector<Opm::CellCostStatistics> statistics;
+    for (int rank = 0; rank < 8; ++rank) {
+        Opm::CellCostStatistics s;
+        s.cells = 1000.0 + 50.0 * rank;
+        s.connections = 5.5 * s.cells + 30.0 * (rank % 3);
+        s.perforations = 10.0 * (rank % 4);
+        s.msPerforations = 2.0 * (rank % 2);
+        s.aquiferConnections = 20.0 * (rank == 5);
+        s.seconds = secondsPerCell * (truth.cell * s.cells
+                                      + truth.connection * s.connections
+                                      + truth.perforation * s.perforations
+                                      + truth.msPerforation * s.msPerforations
+                                      + truth.aquiferConnection * s.aquiferConnections);
+        statistics.push_back(s);
+    }
+
+    const auto fitted = Opm::calibrateCellCosts(statistics, prior);
+    BOOST_CHECK_EQUAL(fitted.cell, 1.0);
+    BOOST_CHECK_CLOSE(fitted.perforation, truth.perforation, 10.0);
+    BOOST_CHECK_GE(fitted.connection, 0.0);
+    BOOST_CHECK_GE(fitted.msPerforation, 0.0);
+
+    // Nothing to fit to.
+    const auto unchanged = Opm::calibrateCellCosts({}, prior);
+    BOOST_CHECK_EQUAL(unchanged.perforation, prior.perforation);
+}
+
+BOOST_AUTO_TEST_CASE(StatisticsFile)
+{
+    const std::string filename = "test_cellcostpartitioning.txt";
+    std::vector<Opm::CellCostStatistics> statistics(2);
+    statistics[0] = {100.0, 550.0, 3.0, 0.0, 1.0, 2.5};
+    statistics[1] = {120.0, 600.0, 0.0, 4.0, 0.0, 3.25};
+    Opm::writeCellCostStatistics(filename, statistics);
+
+    const auto read = Opm::readCellCostStatistics(filename);
+    BOOST_REQUIRE_EQUAL(read.size(), 2u);
+    BOOST_CHECK_EQUAL(read[1].cells, 120.0);
+    BOOST_CHECK_EQUAL(read[1].msPerforations, 4.0);
+    BOOST_CHECK_EQUAL(read[1].seconds, 3.25);
+    BOOST_CHECK(Opm::readCellCostStatistics("does_not_exist.txt").empty());
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,98 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestDeckCache
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/DeckCache.hpp>
+
+#include <opm/common/utility/FileSystem.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <memory>
+#include <string>
+
+BOOST_AUTO_TEST_CASE(CachedInputMatchesParsedInput)
+{
+    const std::string deckFile = "SUMMARY_DECK_NON_CONSTANT_POROSITY.DATA";
+    const std::string cacheFile = "test_deckcache.cache";
+    const std::string settings = "test";
+    auto python = std::make_shared<Opm::Python>();
+
+    Opm::Parser parser;
+    Opm::ParseContext parseContext;
+    Opm::ErrorGuard errorGuard;
+    auto deck = parser.parseFile(deckFile, parseContext, errorGuard);
+    Opm::EclipseState eclState(deck);
+    Opm::Schedule schedule(deck, eclState, parseContext, errorGuard, python);
+    Opm::SummaryConfig summaryConfig(deck, schedule, eclState.fieldProps(),
+                                     eclState.aquifer(), parseContext, errorGuard);
+
+    Opm::writeDeckCache(cacheFile, settings, Opm::deckInputFiles(deck),
+                        deck, schedule, summaryConfig);
+
+    std::unique_ptr<Opm::Deck> cachedDeck;
+    std::unique_ptr<Opm::Schedule> cachedSchedule;
+    std::unique_ptr<Opm::SummaryConfig> cachedSummaryConfig;
+    BOOST_CHECK(!Opm::loadDeckCache(cacheFile, "other", python,
+                                    cachedDeck, cachedSchedule, cachedSummaryConfig));
+    BOOST_CHECK(!cachedDeck);
+    BOOST_REQUIRE(Opm::loadDeckCache(cacheFile, settings, python,
+                                     cachedDeck, cachedSchedule, cachedSummaryConfig));
+
+    // The state is created from the cached deck, as when running from the cache.
+    const Opm::EclipseState cachedState(*cachedDeck);
+    BOOST_CHECK(cachedState.getInputGrid().equal(eclState.getInputGrid()));
+    BOOST_CHECK(cachedState.fieldProps().get_double("PORO") == eclState.fieldProps().get_double("PORO"));
+    BOOST_CHECK(cachedState.fieldProps().get_double("PERMX") == eclState.fieldProps().get_double("PERMX"));
+    BOOST_CHECK(cachedState.fieldProps().get_double("PERMY") == eclState.fieldProps().get_double("PERMY"));
+    BOOST_CHECK(cachedState.fieldProps().get_int("FIPNUM") == eclState.fieldProps().get_int("FIPNUM"));
+    BOOST_CHECK(cachedState.fieldProps().actnum() == eclState.fieldProps().actnum());
+    BOOST_CHECK(*cachedSchedule == schedule);
+    BOOST_CHECK(*cachedSummaryConfig == summaryConfig);
+
+    Opm::filesystem::remove(cacheFile);
+}
+
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
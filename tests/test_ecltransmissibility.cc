@@ -0,0 +1,202 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclTransmissibility
+
+#include <ebos/eclproblem.hh>
+#include <ebos/eclwellmanager.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 < 71
+#include <boost/test/floating_point_comparison.hpp>
+#else
+#include <boost/test/tools/floating_point_comparison.hpp>
+#endif
+
+namespace Opm::Properties {
+namespace TTag {
+
+struct TestTransmissibilityTypeTag {
+    using InheritsFrom = std::tuple<EclBaseProblem, BlackOilModel>;
+};
+}
+
+template<class TypeTag>
+struct EclWellModel<TypeTag, TTag::TestTransmissibilityTypeTag> {
+    using type = EclWellManager<TypeTag>;
+};
+
+} // namespace Opm::Properties
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename)
+{
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+    std::string filenameArg = "--ecl-deck-file-name=";
+    filenameArg += filename;
+
+    const char* argv[] = {
+        "test_ecltransmissibility",
+        filenameArg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/false);
+
+    return std::unique_ptr<Simulator>(new Simulator);
+}
+
+namespace {
+
+struct TransmissibilityFixture {
+    TransmissibilityFixture() {
+    int argc = boost::unit_test::framework::master_test_suite().argc;
+    char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+    Dune::MPIHelper::instance(argc, argv);
+#endif
+        using TypeTag = Opm::Properties::TTag::TestTransmissibilityTypeTag;
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+}
+
+BOOST_GLOBAL_FIXTURE(TransmissibilityFixture);
+
+namespace {
+
+using TestTypeTag = Opm::Properties::TTag::TestTransmissibilityTypeTag;
+using TestSimulator = Opm::GetPropType<TestTypeTag, Opm::Properties::Simulator>;
+using TestTransmissibility = typename Opm::GetPropType<TestTypeTag, Opm::Properties::Vanguard>::TransmissibilityType;
+
+std::unique_ptr<TestTransmissibility> makeTransmissibility(TestSimulator& simulator)
+{
+    auto& vanguard = simulator.vanguard();
+    return std::make_unique<TestTransmissibility>(vanguard.eclState(),
+                                                  vanguard.gridView(),
+                                                  vanguard.cartesianIndexMapper(),
+                                                  vanguard.grid(),
+                                                  vanguard.cellCentroids(),
+                                                  /*enableEnergy=*/false,
+                                                  /*enableDiffusivity=*/false);
+}
+
+// Compare the transmissibilities of all interior faces with a full update.
+void checkMatchesFullUpdate(TestSimulator& simulator, const TestTransmissibility& incremental)
+{
+    using GridView = typename Opm::GetPropType<TestTypeTag, Opm::Properties::Vanguard>::GridView;
+
+    auto full = makeTransmissibility(simulator);
+    full->update(/*global=*/true);
+
+    const auto& gridView = simulator.vanguard().gridView();
+    Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gridView, Dune::mcmgElementLayout());
+    int numFaces = 0;
+    for (const auto& elem : elements(gridView)) {
+        const unsigned elemIdx = elementMapper.index(elem);
+        for (const auto& intersection : intersections(gridView, elem)) {
+            if (!intersection.neighbor())
+                continue;
+
+            const unsigned neighborIdx = elementMapper.index(intersection.outside());
+            BOOST_CHECK_CLOSE(incremental.transmissibility(elemIdx, neighborIdx),
+                              full->transmissibility(elemIdx, neighborIdx), 1e-10);
+            ++numFaces;
+        }
+    }
+    BOOST_CHECK(numFaces > 0);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(UpdateMultipliersMatchesFullUpdate)
+{
+    auto simulator = initSimulator<TestTypeTag>("transmultipliers.DATA");
+    auto& vanguard = simulator->vanguard();
+    auto& eclState = vanguard.eclState();
+
+    // The first call does a full update and records the faces.
+    auto incremental = makeTransmissibility(*simulator);
+    BOOST_CHECK(!incremental->updateMultipliers(/*global=*/true));
+
+    // MULTFLT and MULTX of the second report step.
+    eclState.apply_geo_keywords(vanguard.schedule()[1].geo_keywords());
+    const auto changed = incremental->updateMultipliers(/*global=*/true);
+    BOOST_REQUIRE(changed);
+    BOOST_CHECK(!changed->empty() || vanguard.gridView().comm().size() > 1);
+
+    checkMatchesFullUpdate(*simulator, *incremental);
+
+    // Nothing changes without new multipliers.
+    const auto unchanged = incremental->updateMultipliers(/*global=*/true);
+    BOOST_REQUIRE(unchanged);
+    BOOST_CHECK(unchanged->empty());
+}
+
+BOOST_AUTO_TEST_CASE(ChangedEditNncFaceUpdatesAllProcesses)
+{
+    auto simulator = initSimulator<TestTypeTag>("transmultipliers_editnnc.DATA");
+    auto& vanguard = simulator->vanguard();
+    auto& eclState = vanguard.eclState();
+    const auto& comm = vanguard.gridView().comm();
+
+    // The face scaled by EDITNNC is between the cells (5,1,1) and (6,1,1).
+    int hasEditNncFace = 0;
+    {
+        const auto& cartMapper = vanguard.cartesianIndexMapper();
+        int numFaceCells = 0;
+        for (int elemIdx = 0; elemIdx < vanguard.gridView().size(/*codim=*/0); ++elemIdx) {
+            const int cartIdx = cartMapper.cartesianIndex(elemIdx);
+            numFaceCells += (cartIdx == 4 || cartIdx == 5);
+        }
+        hasEditNncFace = numFaceCells == 2;
+    }
+    BOOST_CHECK(comm.sum(hasEditNncFace) > 0);
+    if (comm.size() > 1)
+        BOOST_CHECK(comm.sum(hasEditNncFace) < comm.size());
+
+    auto incremental = makeTransmissibility(*simulator);
+    BOOST_CHECK(!incremental->updateMultipliers(/*global=*/true));
+
+    // MULTFLT changes the face modified by EDITNNC. Every process has to do
+    // the full update, including those without that face.
+    eclState.apply_geo_keywords(vanguard.schedule()[1].geo_keywords());
+    BOOST_CHECK(!incremental->updateMultipliers(/*global=*/true));
+
+    checkMatchesFullUpdate(*simulator, *incremental);
+}
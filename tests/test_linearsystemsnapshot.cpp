@@ -0,0 +1,181 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE OPM_test_LinearSystemSnapshot
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/LinearSystemSnapshot.hpp>
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr int bz = 2;
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+
+// Tridiagonal matrix with distinct entries in every block.
+Matrix makeMatrix(const int n, const double offset)
+{
+    Matrix matrix(n, n, 3 * n, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0)
+            row.insert(i - 1);
+        row.insert(i);
+        if (i < n - 1)
+            row.insert(i + 1);
+    }
+    double value = offset;
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < bz; ++i) {
+                for (int j = 0; j < bz; ++j) {
+                    (*col)[i][j] = value;
+                    value += 1.0;
+                }
+            }
+        }
+    }
+    return matrix;
+}
+
+Vector makeVector(const int n, const double offset)
+{
+    Vector vector(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < bz; ++j) {
+            vector[i][j] = offset + i * bz + j;
+        }
+    }
+    return vector;
+}
+
+void checkEqual(const Matrix& a, const Matrix& b)
+{
+    BOOST_REQUIRE_EQUAL(a.N(), b.N());
+    BOOST_REQUIRE_EQUAL(a.M(), b.M());
+    BOOST_REQUIRE_EQUAL(a.nonzeroes(), b.nonzeroes());
+    for (auto rowA = a.begin(), rowB = b.begin(); rowA != a.end(); ++rowA, ++rowB) {
+        for (auto colA = rowA->begin(), colB = rowB->begin(); colA != rowA->end(); ++colA, ++colB) {
+            BOOST_CHECK_EQUAL(colA.index(), colB.index());
+            for (int i = 0; i < bz; ++i) {
+                for (int j = 0; j < bz; ++j) {
+                    BOOST_CHECK_EQUAL((*colA)[i][j], (*colB)[i][j]);
+                }
+            }
+        }
+    }
+}
+
+void checkEqual(const Vector& a, const Vector& b)
+{
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        for (int j = 0; j < bz; ++j) {
+            BOOST_CHECK_EQUAL(a[i][j], b[i][j]);
+        }
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(SerialSystem)
+{
+    const std::string filename = "test_linearsystemsnapshot_serial.osys";
+    const int n = 5;
+    const auto matrix = makeMatrix(n, 1.0);
+    const auto rhs = makeVector(n, -3.0);
+
+    Opm::PropertyTree prm;
+    prm.put("tol", 0.01);
+    prm.put("preconditioner.type", std::string("ilu0"));
+
+    Opm::LinearSystemSnapshotLayout layout;
+    layout.interiorSize = n;
+    Opm::writeLinearSystemSnapshot<Matrix, Vector>(filename, matrix, rhs, nullptr, nullptr,
+                                                   layout, 1, prm);
+
+    const auto info = Opm::readLinearSystemSnapshotInfo(filename);
+    BOOST_CHECK_EQUAL(info.blockSize, bz);
+    BOOST_CHECK_EQUAL(info.numRanks, 1);
+    BOOST_CHECK_EQUAL(info.pressureIndex, 1);
+    BOOST_CHECK(!info.hasWellMatrix);
+    BOOST_CHECK(!info.hasWeights);
+
+    const auto snapshot = Opm::readLinearSystemSnapshot<Matrix, Vector>(filename);
+    checkEqual(snapshot.matrix, matrix);
+    checkEqual(snapshot.rhs, rhs);
+    BOOST_CHECK(!snapshot.wellMatrix);
+    BOOST_CHECK(!snapshot.weights);
+    BOOST_CHECK_EQUAL(snapshot.layout.interiorSize, static_cast<std::size_t>(n));
+    BOOST_CHECK(snapshot.layout.globalIndex.empty());
+    BOOST_CHECK_CLOSE(snapshot.prm.get<double>("tol"), 0.01, 1e-12);
+    BOOST_CHECK_EQUAL(snapshot.prm.get<std::string>("preconditioner.type"), "ilu0");
+
+    std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(SystemWithWellsWeightsAndLayout)
+{
+    const std::string filename = "test_linearsystemsnapshot_full.osys";
+    const int n = 4;
+    const auto matrix = makeMatrix(n, 1.0);
+    const auto wellMatrix = makeMatrix(n, 100.0);
+    const auto rhs = makeVector(n, 2.0);
+    const auto weights = makeVector(n, 0.5);
+
+    Opm::LinearSystemSnapshotLayout layout;
+    layout.rank = 1;
+    layout.numRanks = 2;
+    layout.interiorSize = 3;
+    layout.globalIndex = {7, 8, 9, 3};
+    layout.attribute = {1, 1, 1, 2};
+    layout.isPublic = {0, 0, 1, 1};
+    Opm::writeLinearSystemSnapshot(filename, matrix, rhs, &wellMatrix, &weights,
+                                   layout, 0, Opm::PropertyTree());
+
+    const auto snapshot = Opm::readLinearSystemSnapshot<Matrix, Vector>(filename);
+    BOOST_CHECK_EQUAL(snapshot.info.rank, 1);
+    BOOST_CHECK_EQUAL(snapshot.info.numRanks, 2);
+    checkEqual(snapshot.matrix, matrix);
+    checkEqual(snapshot.rhs, rhs);
+    BOOST_REQUIRE(snapshot.wellMatrix);
+    checkEqual(*snapshot.wellMatrix, wellMatrix);
+    BOOST_REQUIRE(snapshot.weights);
+    checkEqual(*snapshot.weights, weights);
+    BOOST_CHECK_EQUAL(snapshot.layout.interiorSize, 3u);
+    BOOST_CHECK(snapshot.layout.globalIndex == layout.globalIndex);
+    BOOST_CHECK(snapshot.layout.attribute == layout.attribute);
+    BOOST_CHECK(snapshot.layout.isPublic == layout.isPublic);
+
+    using OtherMatrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 3, 3>>;
+    using OtherVector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+    BOOST_CHECK_THROW((Opm::readLinearSystemSnapshot<OtherMatrix, OtherVector>(filename)), std::runtime_error);
+
+    std::remove(filename.c_str());
+}
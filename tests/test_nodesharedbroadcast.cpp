@@ -0,0 +1,115 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestNodeSharedBroadcast
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/eclmpiserializer.hh>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Runspec.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+#include <opm/simulators/utils/ParallelEclipseState.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <memory>
+
+namespace {
+
+struct Input
+{
+    std::unique_ptr<Opm::EclipseState> eclState;
+    std::unique_ptr<Opm::Schedule> schedule;
+    std::unique_ptr<Opm::SummaryConfig> summaryConfig;
+};
+
+// The parsed input on the root process, empty objects on the others.
+Input makeInput(std::shared_ptr<Opm::Python> python)
+{
+    Input input;
+    if (Dune::MPIHelper::getCollectiveCommunication().rank() == 0) {
+        Opm::Parser parser;
+        Opm::ParseContext parseContext;
+        Opm::ErrorGuard errorGuard;
+        auto deck = parser.parseFile("SUMMARY_DECK_NON_CONSTANT_POROSITY.DATA", parseContext, errorGuard);
+        input.eclState = std::make_unique<Opm::ParallelEclipseState>(deck);
+        input.schedule = std::make_unique<Opm::Schedule>(deck, *input.eclState, parseContext,
+                                                         errorGuard, python);
+        input.summaryConfig = std::make_unique<Opm::SummaryConfig>(deck, *input.schedule,
+                                                                   input.eclState->fieldProps(),
+                                                                   input.eclState->aquifer(),
+                                                                   parseContext, errorGuard);
+    } else {
+        input.eclState = std::make_unique<Opm::ParallelEclipseState>();
+        input.schedule = std::make_unique<Opm::Schedule>(python);
+        input.summaryConfig = std::make_unique<Opm::SummaryConfig>();
+    }
+    return input;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(NodeSharedBroadcastMatchesBroadcast)
+{
+    auto python = std::make_shared<Opm::Python>();
+    auto comm = Dune::MPIHelper::getCollectiveCommunication();
+
+    auto broadcasted = makeInput(python);
+    Opm::EclMpiSerializer ser(comm);
+    ser.broadcast(*broadcasted.eclState);
+    ser.broadcast(*broadcasted.schedule);
+    ser.broadcast(*broadcasted.summaryConfig);
+
+    auto nodeShared = makeInput(python);
+    Opm::EclMpiSerializer nodeSer(comm);
+    nodeSer.broadcastNodeShared(*nodeShared.eclState);
+    nodeSer.broadcastNodeShared(*nodeShared.schedule);
+    nodeSer.broadcastNodeShared(*nodeShared.summaryConfig);
+
+    BOOST_CHECK(nodeShared.eclState->runspec() == broadcasted.eclState->runspec());
+    BOOST_CHECK(nodeShared.eclState->getTableManager() == broadcasted.eclState->getTableManager());
+    BOOST_CHECK(*nodeShared.schedule == *broadcasted.schedule);
+    BOOST_CHECK(*nodeShared.summaryConfig == *broadcasted.summaryConfig);
+    BOOST_CHECK(nodeShared.schedule->size() > 1);
+}
+
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
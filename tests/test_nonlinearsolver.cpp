@@ -0,0 +1,132 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE NonlinearSolverTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/flow/NonlinearSolverEbos.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// The parts of the model used by the failure prediction.
+struct MockModel
+{
+    double convergenceTargetCnv(const int /* maxIter */) const
+    { return 0.01; }
+
+    int numPhases() const
+    { return 2; }
+};
+
+using TypeTag = Opm::Properties::TTag::EclFlowProblem;
+using Solver = Opm::NonlinearSolverEbos<TypeTag, MockModel>;
+
+Solver makeSolver()
+{
+    typename Solver::SolverParameters param;
+    param.maxIter_ = 10;
+    return Solver(param, std::make_unique<MockModel>());
+}
+
+// A residual history whose last three iterations have the given worst CNV
+// residuals, with both phases alike.
+std::vector<std::vector<double>> history(const int it, const double f2, const double f1, const double f0)
+{
+    std::vector<std::vector<double>> result(it + 1, std::vector<double>(2, 1.0));
+    result[it - 2].assign(2, f2);
+    result[it - 1].assign(2, f1);
+    result[it].assign(2, f0);
+    return result;
+}
+
+struct GlobalFixture
+{
+    GlobalFixture()
+    {
+        int argcDummy = 1;
+        const char *tmp[] = {"test_nonlinearsolver"};
+        char **argvDummy = const_cast<char**>(tmp);
+
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argcDummy, argvDummy);
+#else
+        Dune::MPIHelper::instance(argcDummy, argvDummy);
+#endif
+
+        Opm::FlowMainEbos<TypeTag>::setupParameters_(argcDummy, argvDummy);
+    }
+};
+
+}
+
+BOOST_GLOBAL_FIXTURE(GlobalFixture);
+
+BOOST_AUTO_TEST_CASE(ConvergenceUnlikely)
+{
+    const auto solver = makeSolver();
+
+    // Too few iterations to tell.
+    BOOST_CHECK(!solver.convergenceUnlikely(history(2, 1.0, 1.0, 1.0), 1));
+
+    // Converged, or contracting fast enough.
+    BOOST_CHECK(!solver.convergenceUnlikely(history(2, 1.0, 0.1, 0.005), 2));
+    BOOST_CHECK(!solver.convergenceUnlikely(history(2, 1.0, 0.1, 0.02), 2));
+
+    // Not contracting at all, at this and at the previous check.
+    BOOST_CHECK(solver.convergenceUnlikely(history(3, 1.2, 1.1, 1.3), 3));
+
+    // Contracting too slowly for the remaining iterations.
+    BOOST_CHECK(solver.convergenceUnlikely(history(8, 10.0, 9.0, 8.1), 8));
+
+    // The same contraction is enough without oscillations, but not with
+    // them: a rate of 0.92 needs about 2.2 iterations from 1.2 times the
+    // tolerance, and two iterations are left.
+    const double f2 = 0.012 / (0.92 * 0.92);
+    BOOST_CHECK(!solver.convergenceUnlikely(history(8, f2, 0.013, 0.012), 8));
+    BOOST_CHECK(solver.convergenceUnlikely(history(8, f2, 0.02, 0.012), 8));
+}
+
+BOOST_AUTO_TEST_CASE(EarlyGrowthIsTolerated)
+{
+    const auto solver = makeSolver();
+
+    // The residuals grow at first, e.g. after a well control switch, and
+    // converge later on.
+    const std::vector<double> worst = {0.5, 0.8, 0.6, 0.1, 0.005};
+    std::vector<std::vector<double>> residualHistory;
+    for (int it = 0; it < static_cast<int>(worst.size()); ++it) {
+        residualHistory.emplace_back(2, worst[it]);
+        BOOST_CHECK(!solver.convergenceUnlikely(residualHistory, it));
+    }
+
+    // Not contracting at the first check alone is not enough.
+    BOOST_CHECK(!solver.convergenceUnlikely(history(2, 1.0, 1.2, 1.1), 2));
+}
@@ -434,6 +434,11 @@ void testGlobalPerfFactoryParallel(int num_component, bool local_consecutive = f
     BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(globalCurrent), std::end(globalCurrent),
                                   std::begin(globalCreated), std::end(globalCreated));
 
+    // Second exchange reuses the cached data type and buffers
+    auto globalCreatedAgain = factory.createGlobal(localCurrent, num_component);
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(globalCreated), std::end(globalCreated),
+                                  std::begin(globalCreatedAgain), std::end(globalCreatedAgain));
+
     std::transform(std::begin(globalAdd), std::end(globalAdd),
                    std::begin(globalCreated), std::begin(globalCreated),
                    std::plus<double>());
@@ -0,0 +1,76 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE OPM_test_PerformanceTimers
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/PerformanceTimers.hpp>
+
+#include <string>
+
+namespace {
+
+// The reductions of a single process.
+struct SerialCommunication
+{
+    int rank() const { return 0; }
+    int size() const { return 1; }
+    template<class T> T min(const T& x) const { return x; }
+    template<class T> T max(const T& x) const { return x; }
+    template<class T> T sum(const T& x) const { return x; }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(DisabledTimersDoNotCount)
+{
+    Opm::PerformanceTimers::reset();
+    Opm::PerformanceTimers::enable(false);
+    {
+        Opm::ScopedPerformanceTimer timer(Opm::PerformanceTimers::WellAssembly);
+    }
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::calls(Opm::PerformanceTimers::WellAssembly), 0);
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::seconds(Opm::PerformanceTimers::WellAssembly), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(EnabledTimersAccumulate)
+{
+    Opm::PerformanceTimers::reset();
+    Opm::PerformanceTimers::enable(true);
+    for (int i = 0; i < 3; ++i) {
+        Opm::ScopedPerformanceTimer timer(Opm::PerformanceTimers::ConvergenceReduction);
+    }
+    Opm::PerformanceTimers::add(Opm::PerformanceTimers::OutputCollection, 1.5);
+    Opm::PerformanceTimers::enable(false);
+
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::calls(Opm::PerformanceTimers::ConvergenceReduction), 3);
+    BOOST_CHECK_GE(Opm::PerformanceTimers::seconds(Opm::PerformanceTimers::ConvergenceReduction), 0.0);
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::calls(Opm::PerformanceTimers::OutputCollection), 1);
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::seconds(Opm::PerformanceTimers::OutputCollection), 1.5);
+
+    const auto table = Opm::PerformanceTimers::report(SerialCommunication(), {{"Linear solve", 2.0}});
+    BOOST_CHECK(table.find("Output collection") != std::string::npos);
+    BOOST_CHECK(table.find("Linear solve") != std::string::npos);
+    BOOST_CHECK(table.find("max/mean") != std::string::npos);
+
+    Opm::PerformanceTimers::reset();
+    BOOST_CHECK_EQUAL(Opm::PerformanceTimers::calls(Opm::PerformanceTimers::OutputCollection), 0);
+}
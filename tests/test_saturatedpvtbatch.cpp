@@ -0,0 +1,108 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestSaturatedPvtBatch
+
+#include <boost/test/unit_test.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 < 71
+#include <boost/test/floating_point_comparison.hpp>
+#else
+#include <boost/test/tools/floating_point_comparison.hpp>
+#endif
+
+#include <ebos/eclsaturatedpvtbatch.hh>
+
+#include <opm/material/fluidstates/CompositionalFluidState.hpp>
+#include <opm/material/fluidsystems/BlackOilFluidSystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+#include <opm/parser/eclipse/Units/Units.hpp>
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(BatchMatchesPerCellEvaluation)
+{
+    using FluidSystem = Opm::BlackOilFluidSystem<double>;
+    using FluidState = Opm::CompositionalFluidState<double, FluidSystem>;
+    using Batch = Opm::EclSaturatedPvtBatch<FluidSystem, double>;
+
+    Opm::Parser parser;
+    auto python = std::make_shared<Opm::Python>();
+    const auto deck = parser.parseFile("saturatedpvt.DATA");
+    const Opm::EclipseState eclState(deck);
+    const Opm::Schedule schedule(deck, eclState, python);
+    FluidSystem::initFromState(eclState, schedule);
+
+    // More cells than fit into one range, with the regions interleaved.
+    const unsigned numCells = 10000;
+    std::vector<unsigned> pvtRegionIdx(numCells);
+    for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx)
+        pvtRegionIdx[cellIdx] = (cellIdx / 7) % 2;
+
+    Batch batch;
+    batch.init(pvtRegionIdx);
+    BOOST_CHECK(!batch.empty());
+
+    std::vector<FluidState> fluidStates(numCells);
+    std::vector<double> maxOilSaturation(numCells);
+    for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        const double x = static_cast<double>(cellIdx) / numCells;
+        auto& fs = fluidStates[cellIdx];
+        fs.setTemperature(273.15 + 60.0);
+        fs.setPressure(FluidSystem::oilPhaseIdx, (20.0 + 450.0*x)*Opm::unit::barsa);
+        fs.setPressure(FluidSystem::gasPhaseIdx, (21.0 + 300.0*x)*Opm::unit::barsa);
+        fs.setPressure(FluidSystem::waterPhaseIdx, (19.0 + 450.0*x)*Opm::unit::barsa);
+        fs.setSaturation(FluidSystem::oilPhaseIdx, 0.3 + 0.5*x);
+        fs.setSaturation(FluidSystem::gasPhaseIdx, 0.1);
+        fs.setSaturation(FluidSystem::waterPhaseIdx, 0.6 - 0.5*x);
+        maxOilSaturation[cellIdx] = 0.9;
+
+        batch.setCell(cellIdx,
+                      fs.temperature(FluidSystem::oilPhaseIdx),
+                      fs.pressure(FluidSystem::oilPhaseIdx),
+                      fs.pressure(FluidSystem::gasPhaseIdx),
+                      fs.saturation(FluidSystem::oilPhaseIdx),
+                      maxOilSaturation[cellIdx]);
+    }
+
+    std::vector<double> rsSat(numCells);
+    std::vector<double> rvSat(numCells);
+    batch.saturatedGasDissolutionFactor(rsSat);
+    batch.saturatedOilVaporizationFactor(rvSat);
+
+    for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+        const auto& fs = fluidStates[cellIdx];
+        const unsigned regionIdx = pvtRegionIdx[cellIdx];
+        const double SoMax = maxOilSaturation[cellIdx];
+        BOOST_CHECK_CLOSE(rsSat[cellIdx],
+                          FluidSystem::saturatedDissolutionFactor(fs, FluidSystem::oilPhaseIdx, regionIdx, SoMax),
+                          1e-12);
+        BOOST_CHECK_CLOSE(rvSat[cellIdx],
+                          FluidSystem::saturatedDissolutionFactor(fs, FluidSystem::gasPhaseIdx, regionIdx, SoMax),
+                          1e-12);
+    }
+}
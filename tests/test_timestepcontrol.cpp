@@ -0,0 +1,94 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TimeStepControlTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/timestepping/TimeStepControl.hpp>
+
+#include <memory>
+
+namespace {
+
+class NoRelativeChange : public Opm::RelativeChangeInterface
+{
+public:
+    double relativeChange() const override
+    { return 0.0; }
+};
+
+// Suggests a fixed time step size.
+class FixedTimeStepControl : public Opm::TimeStepControlInterface
+{
+public:
+    double computeTimeStepSize(const double, const int, const Opm::RelativeChangeInterface&, const double) const override
+    { return suggestion; }
+
+    double suggestion = 10.0;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(FailedStepLimitsGrowth)
+{
+    auto fixed = std::make_unique<FixedTimeStepControl>();
+    auto& inner = *fixed;
+    Opm::FailedStepLimitedTimeStepControl control(std::move(fixed), 0.5, 1.25);
+    const NoRelativeChange relativeChange;
+
+    // Without failures the suggestions pass through.
+    BOOST_CHECK_EQUAL(control.computeTimeStepSize(5.0, 3, relativeChange, 0.0), 10.0);
+    control.registerConvergedStep(5.0, 10.0);
+
+    // A failed step of 8 limits the following steps to 4, growing by 1.25
+    // with every converged step.
+    control.registerFailedStep(8.0);
+    double dt = 2.64;
+    const double expected[] = {5.0, 6.25, 7.8125, 9.765625};
+    for (const double limit : expected) {
+        const double dtEstimate = control.computeTimeStepSize(dt, 3, relativeChange, 0.0);
+        BOOST_CHECK_CLOSE(dtEstimate, limit, 1e-12);
+        // Computing a suggestion does not change the limit.
+        BOOST_CHECK_EQUAL(control.computeTimeStepSize(dt, 3, relativeChange, 0.0), dtEstimate);
+        control.registerConvergedStep(dt, dtEstimate);
+        dt = dtEstimate;
+    }
+
+    // Once the other control suggests less, the limit is forgotten.
+    const double dtEstimate = control.computeTimeStepSize(dt, 3, relativeChange, 0.0);
+    BOOST_CHECK_EQUAL(dtEstimate, 10.0);
+    control.registerConvergedStep(dt, dtEstimate);
+    inner.suggestion = 100.0;
+    BOOST_CHECK_EQUAL(control.computeTimeStepSize(10.0, 3, relativeChange, 0.0), 100.0);
+
+    // Further failures only ever lower the limit.
+    control.registerFailedStep(40.0);
+    control.registerFailedStep(100.0);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(10.0, 3, relativeChange, 0.0), 25.0, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(FailedStepLimitedParameters)
+{
+    BOOST_CHECK_THROW(Opm::FailedStepLimitedTimeStepControl(std::make_unique<FixedTimeStepControl>(), 0.0, 1.25),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(Opm::FailedStepLimitedTimeStepControl(std::make_unique<FixedTimeStepControl>(), 0.5, 0.9),
+                      std::runtime_error);
+}
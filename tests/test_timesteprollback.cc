@@ -0,0 +1,185 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE TimeStepRollback
+
+#include <ebos/eclproblem.hh>
+#include <ebos/eclwellmanager.hh>
+#include <opm/models/utils/start.hh>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+namespace TTag {
+
+struct TestTimeStepRollbackTypeTag {
+    using InheritsFrom = std::tuple<EclBaseProblem, BlackOilModel>;
+};
+}
+
+template<class TypeTag>
+struct EclWellModel<TypeTag, TTag::TestTimeStepRollbackTypeTag> {
+    using type = EclWellManager<TypeTag>;
+};
+
+} // namespace Opm::Properties
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename)
+{
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+    std::string filenameArg = "--ecl-deck-file-name=";
+    filenameArg += filename;
+
+    const char* argv[] = {
+        "test_timesteprollback",
+        filenameArg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/false);
+
+    return std::unique_ptr<Simulator>(new Simulator);
+}
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestTimeStepRollbackTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+struct TimeStepRollbackFixture {
+    TimeStepRollbackFixture() {
+    int argc = boost::unit_test::framework::master_test_suite().argc;
+    char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+    Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+// The history dependent quantities of one cell.
+struct HistoryState
+{
+    double maxOilSaturation;
+    double pcSwMdc;
+    double krnSwMdc;
+    double minOilPressure;
+};
+
+HistoryState historyState(Simulator& simulator, const unsigned dofIdx)
+{
+    auto& problem = simulator.problem();
+    HistoryState state;
+    state.maxOilSaturation = problem.maxOilSaturation(dofIdx);
+    problem.materialLawManager()->oilWaterHysteresisParams(state.pcSwMdc, state.krnSwMdc, dofIdx);
+    state.minOilPressure = problem.minOilPressure(dofIdx);
+    return state;
+}
+
+double cachedOilPressure(const Simulator& simulator, const unsigned dofIdx)
+{
+    using FluidSystem = Opm::GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+
+    const auto* iq = simulator.model().cachedIntensiveQuantities(dofIdx, /*timeIdx=*/0);
+    BOOST_REQUIRE(iq);
+    return Opm::getValue(iq->fluidState().pressure(FluidSystem::oilPhaseIdx));
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(TimeStepRollbackFixture);
+
+BOOST_AUTO_TEST_CASE(RolledBackStepKeepsHistory)
+{
+    using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+
+    auto simulator = initSimulator<TypeTag>("timesteprollback.DATA");
+    auto& model = simulator->model();
+    auto& problem = simulator->problem();
+
+    model.applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(86400);
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    // The first attempt of the step updates the history dependent
+    // quantities from its start solution.
+    problem.beginTimeStep();
+
+    const unsigned numDof = model.numGridDof();
+    BOOST_REQUIRE(numDof > 1);
+    std::vector<HistoryState> startHistory;
+    for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx)
+        startHistory.push_back(historyState(*simulator, dofIdx));
+
+    // A solution which would change all history dependent quantities of
+    // every second cell: more oil, less water and a lower pressure.
+    for (unsigned dofIdx = 1; dofIdx < numDof; dofIdx += 2) {
+        auto& priVars = model.solution(/*timeIdx=*/0)[dofIdx];
+        priVars[Indices::waterSaturationIdx] -= 0.05;
+        priVars[Indices::pressureSwitchIdx] -= 10e5;
+    }
+    model.invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    // Put the intensive quantities of cell 1 into the slot of cell 0. They
+    // stay there unless the intensive quantities are recomputed.
+    const double markerPressure = cachedOilPressure(*simulator, 1);
+    BOOST_REQUIRE(markerPressure != cachedOilPressure(*simulator, 0));
+    model.updateCachedIntensiveQuantities(*model.cachedIntensiveQuantities(1, /*timeIdx=*/0),
+                                          /*globalIdx=*/0, /*timeIdx=*/0);
+
+    problem.timeStepRolledBack();
+    problem.beginTimeStep();
+
+    for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+        const auto state = historyState(*simulator, dofIdx);
+        BOOST_CHECK_EQUAL(state.maxOilSaturation, startHistory[dofIdx].maxOilSaturation);
+        BOOST_CHECK_EQUAL(state.pcSwMdc, startHistory[dofIdx].pcSwMdc);
+        BOOST_CHECK_EQUAL(state.krnSwMdc, startHistory[dofIdx].krnSwMdc);
+        BOOST_CHECK_EQUAL(state.minOilPressure, startHistory[dofIdx].minOilPressure);
+    }
+    BOOST_CHECK_EQUAL(cachedOilPressure(*simulator, 0), markerPressure);
+
+    // Without the rollback the same solution updates all of them, and the
+    // intensive quantities are recomputed.
+    problem.beginTimeStep();
+
+    const auto state = historyState(*simulator, 1);
+    BOOST_CHECK(state.maxOilSaturation > startHistory[1].maxOilSaturation);
+    BOOST_CHECK(state.pcSwMdc < startHistory[1].pcSwMdc);
+    BOOST_CHECK(state.minOilPressure < startHistory[1].minOilPressure);
+    BOOST_CHECK(cachedOilPressure(*simulator, 0) != markerPressure);
+}
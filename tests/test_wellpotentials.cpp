@@ -0,0 +1,210 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE WellPotentials
+
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/models/utils/start.hh>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm {
+
+// Gives access to the computation of the well potentials.
+template <class TypeTag>
+class TestWellModel : public BlackoilWellModel<TypeTag>
+{
+public:
+    using BlackoilWellModel<TypeTag>::BlackoilWellModel;
+    using BlackoilWellModel<TypeTag>::updateWellPotentials;
+};
+
+} // namespace Opm
+
+namespace Opm::Properties {
+namespace TTag {
+
+struct TestWellPotentialsTypeTag {
+    using InheritsFrom = std::tuple<EclFlowProblem>;
+};
+}
+
+template<class TypeTag>
+struct EclWellModel<TypeTag, TTag::TestWellPotentialsTypeTag> {
+    using type = TestWellModel<TypeTag>;
+};
+
+} // namespace Opm::Properties
+
+template <class TypeTag>
+std::unique_ptr<Opm::GetPropType<TypeTag, Opm::Properties::Simulator>>
+initSimulator(const char *filename)
+{
+    using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+    std::string filenameArg = "--ecl-deck-file-name=";
+    filenameArg += filename;
+
+    const char* argv[] = {
+        "test_wellpotentials",
+        filenameArg.c_str()
+    };
+
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv)/sizeof(argv[0]), argv, /*registerParams=*/false);
+
+    return std::unique_ptr<Simulator>(new Simulator);
+}
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestWellPotentialsTypeTag;
+using WellModel = Opm::TestWellModel<TypeTag>;
+
+const std::vector<std::string> wellNames = {"P1", "P2", "P3", "P4", "I1", "I2"};
+
+struct WellPotentialsFixture {
+    WellPotentialsFixture() {
+    int argc = boost::unit_test::framework::master_test_suite().argc;
+    char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+    Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::registerAllParameters_<TypeTag>();
+    }
+};
+
+// Set up the wells of the first report step.
+template <class Simulator>
+WellModel& prepareWells(Simulator& simulator)
+{
+    simulator.model().applyInitialSolution();
+    simulator.setEpisodeIndex(-1);
+    simulator.setEpisodeLength(0.0);
+    simulator.startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator.setTimeStepSize(43200);  // 12 hours
+    simulator.model().newtonMethod().setIterationIndex(0);
+
+    WellModel& wellModel = simulator.problem().wellModel();
+    wellModel.beginReportStep(/*reportStepIdx=*/0);
+    wellModel.beginTimeStep();
+    return wellModel;
+}
+
+// The potentials of all wells, in the order of wellNames.
+std::vector<std::vector<double>> potentials(const WellModel& wellModel)
+{
+    std::vector<std::vector<double>> result;
+    for (const auto& name : wellNames) {
+        const auto wellPotentials = wellModel.wellState().wellPotentials(wellModel.getWell(name)->indexOfWell());
+        result.emplace_back(wellPotentials.begin(), wellPotentials.end());
+    }
+    return result;
+}
+
+}
+
+BOOST_GLOBAL_FIXTURE(WellPotentialsFixture);
+
+BOOST_AUTO_TEST_CASE(ThreadedPotentials)
+{
+    auto simulator = initSimulator<TypeTag>("wellpotentials.DATA");
+    auto& wellModel = prepareWells(*simulator);
+
+    // None of the wells communicate, so they are all computed by the
+    // threaded loop.
+    for (const auto& name : wellNames)
+        BOOST_CHECK_EQUAL(wellModel.getWell(name)->parallelWellInfo().communication().size(), 1);
+
+#ifdef _OPENMP
+    const int numThreads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    BOOST_CHECK(omp_get_max_threads() > 1);
+#endif
+    Opm::DeferredLogger deferredLogger;
+    wellModel.updateWellPotentials(/*reportStepIdx=*/0, /*onlyAfterEvent=*/false,
+                                   simulator->vanguard().summaryConfig(), deferredLogger);
+#ifdef _OPENMP
+    omp_set_num_threads(numThreads);
+#endif
+
+    for (const auto& wellPotentials : potentials(wellModel)) {
+        double total = 0.0;
+        for (const double potential : wellPotentials)
+            total += std::abs(potential);
+        BOOST_CHECK(total > 0.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThreadedPotentialsMatchSerial)
+{
+    auto simulator = initSimulator<TypeTag>("wellpotentials.DATA");
+    auto& wellModel = prepareWells(*simulator);
+    const auto& summaryConfig = simulator->vanguard().summaryConfig();
+
+    auto computePotentials = [&wellModel, &summaryConfig](const int numThreads) {
+#ifdef _OPENMP
+        const int oldNumThreads = omp_get_max_threads();
+        omp_set_num_threads(numThreads);
+#else
+        static_cast<void>(numThreads);
+#endif
+        Opm::DeferredLogger deferredLogger;
+        wellModel.updateWellPotentials(/*reportStepIdx=*/0, /*onlyAfterEvent=*/false,
+                                       summaryConfig, deferredLogger);
+#ifdef _OPENMP
+        omp_set_num_threads(oldNumThreads);
+#endif
+        return potentials(wellModel);
+    };
+
+    // All wells solve on the same copy of the well state concurrently, which
+    // must not change their potentials. Several rounds give different
+    // interleavings of the threads a chance.
+    const auto serial = computePotentials(1);
+    for (int round = 0; round < 5; ++round) {
+        const auto threaded = computePotentials(4);
+        BOOST_REQUIRE_EQUAL(threaded.size(), serial.size());
+        for (std::size_t wellIdx = 0; wellIdx < serial.size(); ++wellIdx) {
+            BOOST_REQUIRE_EQUAL(threaded[wellIdx].size(), serial[wellIdx].size());
+            for (std::size_t p = 0; p < serial[wellIdx].size(); ++p)
+                BOOST_CHECK_EQUAL(threaded[wellIdx][p], serial[wellIdx][p]);
+        }
+    }
+}
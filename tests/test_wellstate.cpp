@@ -24,10 +24,12 @@
 #include "MpiFixture.hpp"
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/simulators/wells/GlobalWellInfo.hpp>
+#include <opm/simulators/wells/GroupTree.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/simulators/wells/SegmentState.hpp>
 #include <opm/simulators/wells/WellContainer.hpp>
+#include <opm/simulators/wells/WellPhaseContainer.hpp>
 #include <opm/simulators/wells/PerfData.hpp>
 #include <opm/parser/eclipse/Python/Python.hpp>
 
@@ -488,6 +490,111 @@ BOOST_AUTO_TEST_CASE(TESTWellContainer) {
 
     auto wx = wci.well_index("WX");
     BOOST_CHECK(!wx.has_value());
+
+    // Copies share the well names until one of them adds a well.
+    auto wci2 = wci;
+    BOOST_CHECK(wci2.same_wells(wci));
+    wci2["W1"] = 100;
+    BOOST_CHECK_EQUAL(wci["W1"], 1);
+    wci2.add("W4", 4);
+    BOOST_CHECK(!wci2.same_wells(wci));
+    BOOST_CHECK(!wci.has("W4"));
+    BOOST_CHECK_EQUAL(wci.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(TESTWellPhaseContainer) {
+    Opm::WellPhaseContainer wpc;
+    BOOST_CHECK(wpc.empty());
+
+    wpc.add("W1", {1, 2, 3});
+    wpc.add("W2", {4, 5, 6});
+    BOOST_CHECK_EQUAL(wpc.size(), 2);
+    BOOST_CHECK_EQUAL(wpc.numPhases(), 3);
+    BOOST_CHECK_THROW(wpc.add("W1", {1, 2, 3}), std::exception);
+    BOOST_CHECK_THROW(wpc.add("W3", {1, 2}), std::exception);
+
+    BOOST_CHECK_EQUAL(wpc[1][0], 4);
+    BOOST_CHECK_EQUAL(wpc["W1"][2], 3);
+    BOOST_CHECK_EQUAL(wpc[1].size(), 3);
+    BOOST_CHECK_THROW(wpc[10], std::exception);
+    BOOST_CHECK_THROW(wpc["INVALID_WELL"], std::exception);
+
+    wpc["W2"][1] = 50;
+    BOOST_CHECK_EQUAL(wpc[1][1], 50);
+
+    const std::vector<double> expected{1, 2, 3, 4, 50, 6};
+    BOOST_CHECK_EQUAL_COLLECTIONS(wpc.data().begin(), wpc.data().end(),
+                                  expected.begin(), expected.end());
+
+    Opm::WellPhaseContainer wpc2;
+    wpc2.add("W2", {0, 0, 0});
+    wpc2.copy_welldata(wpc, "W2");
+    BOOST_CHECK_EQUAL(wpc2[0][1], 50);
+    BOOST_CHECK_THROW(wpc2.copy_welldata(wpc, "W1"), std::exception);
+
+    auto wpc3 = wpc;
+    wpc3[0][0] = -1;
+    BOOST_CHECK_EQUAL(wpc[0][0], 1);
+
+    wpc.clear();
+    BOOST_CHECK(wpc.empty());
+    BOOST_CHECK(!wpc.has("W1"));
+}
+
+BOOST_AUTO_TEST_CASE(TESTGroupTree) {
+    const Setup setup{ "wells_group.data" };
+
+    const Opm::GroupTree tree(setup.sched, 0);
+    BOOST_CHECK_EQUAL(tree.reportStep(), 0);
+    BOOST_CHECK_EQUAL(tree.numGroups(), 3);
+    BOOST_CHECK_EQUAL(tree.numWells(), 2);
+    BOOST_CHECK(tree.hasWell("INJ1"));
+    BOOST_CHECK(!tree.hasWell("INJ2"));
+    BOOST_CHECK(tree.hasGroup("G1"));
+    BOOST_CHECK(!tree.hasGroup("INJ1"));
+    BOOST_CHECK_THROW(tree.groupIndex("NO_SUCH_GROUP"), std::exception);
+
+    BOOST_CHECK_EQUAL(tree.parent("INJ1"), "G1");
+    BOOST_CHECK_EQUAL(tree.parent("G2"), "FIELD");
+    BOOST_CHECK_THROW(tree.parent("FIELD"), std::exception);
+
+    const auto& inj1 = tree.well(tree.wellIndex("INJ1"));
+    BOOST_CHECK(inj1.injector);
+    BOOST_CHECK(!inj1.shut);
+    BOOST_CHECK_EQUAL(inj1.efficiency_factor, 0.5);
+    BOOST_CHECK_EQUAL(tree.group(inj1.parent).name, "G1");
+
+    const auto& field = tree.group(tree.groupIndex("FIELD"));
+    BOOST_CHECK_EQUAL(field.parent, -1);
+    BOOST_CHECK_EQUAL(field.groups.size(), 2);
+
+    const std::vector<std::string> expected{"FIELD", "G2", "PROD1"};
+    const auto chain = tree.chainTopBot("PROD1", "FIELD");
+    BOOST_CHECK_EQUAL_COLLECTIONS(chain.begin(), chain.end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_THROW(tree.chainTopBot("PROD1", "G1"), std::exception);
+
+    const Opm::GroupTree tree1(setup.sched, 1);
+    BOOST_CHECK(tree1.hasWell("INJ2"));
+    BOOST_CHECK_EQUAL(tree1.group(tree1.groupIndex("G1")).wells.size(), 2);
+
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    auto wstate = buildWellState(setup, 0, pinfos);
+    const auto copy = wstate;
+    BOOST_CHECK(wstate.groupTree(setup.sched, 0) == copy.groupTree(setup.sched, 0));
+    BOOST_CHECK(wstate.groupTree(setup.sched, 1) == wstate.groupTree(setup.sched, 1));
+    BOOST_CHECK(wstate.groupTree(setup.sched, 1)->hasWell("INJ2"));
+
+    // Changes of the Schedule, as done by actions, need a rebuilt tree.
+    auto sched = setup.sched;
+    sched.shut_well("INJ1", 0);
+    const auto old_tree = wstate.groupTree(sched, 0);
+    BOOST_CHECK(!old_tree->well(old_tree->wellIndex("INJ1")).shut);
+    wstate.updateGroupTree(sched);
+    const auto new_tree = wstate.groupTree(sched, 0);
+    BOOST_CHECK(new_tree != old_tree);
+    BOOST_CHECK(new_tree->well(new_tree->wellIndex("INJ1")).shut);
+    BOOST_CHECK(copy.groupTree(sched, 0) == old_tree);
 }
 
 BOOST_AUTO_TEST_CASE(TESTSegmentState) {